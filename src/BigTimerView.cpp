@@ -0,0 +1,344 @@
+#include "BigTimerView.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "SessionLog.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const int glyphHeight = 5;
+
+// Bitmap rows, most significant of the used bits on the left
+struct Glyph {
+    int width;
+    uint8_t rows[glyphHeight];
+};
+
+constexpr Glyph digitGlyphs[10] = {
+    { 3, { 0b111, 0b101, 0b101, 0b101, 0b111 } },
+    { 3, { 0b010, 0b110, 0b010, 0b010, 0b111 } },
+    { 3, { 0b111, 0b001, 0b111, 0b100, 0b111 } },
+    { 3, { 0b111, 0b001, 0b111, 0b001, 0b111 } },
+    { 3, { 0b101, 0b101, 0b111, 0b001, 0b001 } },
+    { 3, { 0b111, 0b100, 0b111, 0b001, 0b111 } },
+    { 3, { 0b111, 0b100, 0b111, 0b101, 0b111 } },
+    { 3, { 0b111, 0b001, 0b010, 0b010, 0b010 } },
+    { 3, { 0b111, 0b101, 0b111, 0b101, 0b111 } },
+    { 3, { 0b111, 0b101, 0b111, 0b001, 0b111 } },
+};
+constexpr Glyph colonGlyph = { 1, { 0b0, 0b1, 0b0, 0b1, 0b0 } };
+
+static_assert(digitGlyphs[8].rows[2] == 0b111, "glyph table rows are top to bottom");
+
+#ifdef _WIN32
+// The default console code page has no block characters
+const char fullBlock[] = "#";
+const char lightBlock[] = "-";
+#else
+const char fullBlock[] = "\xe2\x96\x88";    // U+2588
+const char lightBlock[] = "\xe2\x96\x91";   // U+2591
+#endif
+const size_t blockBytes = sizeof(fullBlock) - 1;
+
+// Non-digit rows: state line, gap, progress bar, key hints
+const int reservedRows = 4;
+const int maxGlyphs = 12;
+
+#ifndef _WIN32
+volatile std::sig_atomic_t resizePending = 1;
+
+void onResize(int) {
+    resizePending = 1;
+}
+#endif
+
+// Appends to a frame buffer that was sized for the worst case beforehand
+class FrameWriter {
+public:
+    explicit FrameWriter(char* out) : start(out), out(out) {}
+
+    void bytes(const char* data, size_t length) {
+        std::memcpy(out, data, length);
+        out += length;
+    }
+    void literal(const char* text) { bytes(text, std::strlen(text)); }
+    // run holds at least count copies of one character
+    void repeat(const char* run, size_t characterBytes, int count) {
+        if (count > 0) bytes(run, characterBytes * static_cast<size_t>(count));
+    }
+    void spaces(int count) {
+        if (count <= 0) return;
+        std::memset(out, ' ', static_cast<size_t>(count));
+        out += count;
+    }
+    // Copies at most maxColumns characters (UTF-8 aware); returns the columns used
+    int text(const char* value, int maxColumns) {
+        int used = 0;
+        for (const char* p = value; *p; ++p) {
+            bool lead = (static_cast<unsigned char>(*p) & 0xC0) != 0x80;
+            if (lead && used == maxColumns) break;
+            if (lead) used++;
+            *out++ = *p;
+        }
+        return used;
+    }
+    // Clear the rest of the row and move to the next one
+    void endRow(bool last) {
+        literal("\x1b[K");
+        if (!last) literal("\r\n");
+    }
+
+    size_t size() const { return static_cast<size_t>(out - start); }
+    char* position() const { return out; }
+
+private:
+    char* start;
+    char* out;
+};
+
+} // namespace
+
+BigTimerView::BigTimerView() : length(0), columns(80), rows(24), active(false) {
+#ifndef _WIN32
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onResize;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGWINCH, &action, nullptr);
+#endif
+}
+
+BigTimerView::~BigTimerView() {
+    leave();
+}
+
+void BigTimerView::enter() {
+    if (active) return;
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(console, &mode)) SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+    std::cout << "\x1b[?1049h\x1b[?25l" << std::flush;
+    active = true;
+    querySize();
+}
+
+void BigTimerView::leave() {
+    if (!active) return;
+    std::cout << "\x1b[?25h\x1b[?1049l" << std::flush;
+    active = false;
+}
+
+void BigTimerView::querySize() {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        columns = info.srWindow.Right - info.srWindow.Left + 1;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+#else
+    resizePending = 0;
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+        columns = size.ws_col;
+        rows = size.ws_row;
+    }
+#endif
+    reserveFor(columns, rows);
+}
+
+void BigTimerView::reserveFor(int frameColumns, int frameRows) {
+    // Every cell may be a multi-byte character (up to 4 bytes), plus escape sequences per row
+    size_t needed = static_cast<size_t>(frameRows) * (static_cast<size_t>(frameColumns) * 4 + 8) + 64;
+    if (frame.size() < needed) frame.resize(needed);
+
+    // Runs of block characters so a bar or digit segment is a single copy
+    size_t runBytes = static_cast<size_t>(frameColumns) * blockBytes;
+    if (fullRun.size() < runBytes) {
+        fullRun.resize(runBytes);
+        lightRun.resize(runBytes);
+        for (size_t i = 0; i < runBytes; i += blockBytes) {
+            std::memcpy(&fullRun[i], fullBlock, blockBytes);
+            std::memcpy(&lightRun[i], lightBlock, blockBytes);
+        }
+    }
+}
+
+size_t BigTimerView::compose(int frameColumns, int frameRows, const char* label, int seconds, double progress,
+                             const char* tag, const char* hint) {
+    frameColumns = std::max(frameColumns, 1);
+    frameRows = std::max(frameRows, 1);
+    reserveFor(frameColumns, frameRows);
+    if (seconds < 0) seconds = 0;
+    progress = std::min(1.0, std::max(0.0, progress));
+
+    // Glyphs for M..M:SS (at least two minute digits)
+    const Glyph* glyphs[maxGlyphs];
+    int glyphCount = 0;
+    char digits[maxGlyphs];
+    int minutes = std::min(seconds / 60, 99999);
+    int digitCount = 0;
+    do {
+        digits[digitCount++] = static_cast<char>(minutes % 10);
+        minutes /= 10;
+    } while (minutes > 0 || digitCount < 2);
+    while (digitCount > 0) glyphs[glyphCount++] = &digitGlyphs[static_cast<int>(digits[--digitCount])];
+    glyphs[glyphCount++] = &colonGlyph;
+    glyphs[glyphCount++] = &digitGlyphs[(seconds % 60) / 10];
+    glyphs[glyphCount++] = &digitGlyphs[seconds % 10];
+
+    int units = glyphCount - 1;     // one unit of gap between glyphs
+    for (int i = 0; i < glyphCount; ++i) units += glyphs[i]->width;
+
+    // Terminal cells are about twice as tall as wide, so scale x twice as much as y
+    int scaleY = (frameRows - reservedRows) / glyphHeight;
+    int scaleX = (frameColumns - 2) / units;
+    if (scaleX > 2 * scaleY) scaleX = 2 * scaleY;
+    if (scaleY * 2 > scaleX) scaleY = (scaleX + 1) / 2;
+    bool big = scaleX >= 1 && scaleY >= 1;
+    int digitRows = big ? glyphHeight * scaleY : 1;
+
+    int top = std::max(2, (frameRows - (digitRows + 2)) / 2);
+    int barRow = top + digitRows + 1;
+
+    FrameWriter out(frame.data());
+    out.literal("\x1b[H");
+    // Digit rows repeat scaleY times; later copies are taken from the first
+    const char* glyphRowStart = nullptr;
+    size_t glyphRowBytes = 0;
+    int lastGlyphRow = -1;
+    for (int row = 0; row < frameRows; ++row) {
+        bool last = row == frameRows - 1;
+        if (row == 0) {
+            out.spaces(1);
+            int used = 1 + out.text(label, frameColumns - 1);
+            if (tag && *tag && used + 4 < frameColumns) {
+                out.literal("  - ");
+                out.text(tag, frameColumns - used - 4);
+            }
+        } else if (last && row > 0) {
+            out.spaces(1);
+            out.text(hint, frameColumns - 1);
+        } else if (row >= top && row < top + digitRows) {
+            int glyphRow = (row - top) / (big ? scaleY : 1);
+            if (big && glyphRow == lastGlyphRow) {
+                out.bytes(glyphRowStart, glyphRowBytes);
+            } else if (big) {
+                glyphRowStart = out.position();
+                out.spaces((frameColumns - units * scaleX) / 2);
+                for (int i = 0; i < glyphCount; ++i) {
+                    const Glyph& glyph = *glyphs[i];
+                    for (int bit = glyph.width - 1; bit >= 0; --bit) {
+                        if (glyph.rows[glyphRow] & (1 << bit)) {
+                            out.repeat(fullRun.data(), blockBytes, scaleX);
+                        } else {
+                            out.spaces(scaleX);
+                        }
+                    }
+                    if (i + 1 < glyphCount) out.spaces(scaleX);
+                }
+                glyphRowBytes = static_cast<size_t>(out.position() - glyphRowStart);
+                lastGlyphRow = glyphRow;
+            } else {
+                // Too small for block digits
+                char text[16];
+                int textLength = std::snprintf(text, sizeof(text), "%02d:%02d", seconds / 60, seconds % 60);
+                out.spaces((frameColumns - textLength) / 2);
+                out.text(text, frameColumns);
+            }
+        } else if (row == barRow && frameColumns >= 12) {
+            int barWidth = frameColumns - 9;
+            int filled = static_cast<int>(progress * barWidth + 0.5);
+            char percent[8];
+            std::snprintf(percent, sizeof(percent), " %3d%%", static_cast<int>(progress * 100 + 0.5));
+            out.literal(" [");
+            out.repeat(fullRun.data(), blockBytes, filled);
+            out.repeat(lightRun.data(), blockBytes, barWidth - filled);
+            out.literal("]");
+            out.literal(percent);
+        }
+        out.endRow(last);
+    }
+    length = out.size();
+    return length;
+}
+
+void BigTimerView::render(const char* label, int seconds, double progress, const char* tag, const char* hint) {
+#ifdef _WIN32
+    querySize();
+#else
+    if (resizePending) querySize();
+#endif
+    compose(columns, rows, label, seconds, progress, tag, hint);
+    std::cout.flush();
+#ifdef _WIN32
+    std::fwrite(frame.data(), 1, length, stdout);
+    std::fflush(stdout);
+#else
+    size_t written = 0;
+    while (written < length) {
+        ssize_t n = write(STDOUT_FILENO, frame.data() + written, length - written);
+        if (n <= 0) break;
+        written += static_cast<size_t>(n);
+    }
+#endif
+}
+
+int runBigClockCommand(int argc, char* argv[]) {
+    const char* usage = "Usage: ADHDPomodoro-CLI bigclock bench [frames=100000] [cols=120] [rows=40]";
+    std::string action = argc > 2 ? argv[2] : "";
+    int frames = 100000;
+    int benchColumns = 120;
+    int benchRows = 40;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "frames" && parseOptionValue(value, frames)) {
+            frames = std::max(1, frames);
+        } else if (key == "cols" && parseOptionValue(value, benchColumns)) {
+            benchColumns = std::max(1, benchColumns);
+        } else if (key == "rows" && parseOptionValue(value, benchRows)) {
+            benchRows = std::max(1, benchRows);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+    if (action != "bench") {
+        std::cerr << usage << std::endl;
+        return 1;
+    }
+
+    BigTimerView view;
+    view.compose(benchColumns, benchRows, "FOCUS", 0, 0, "", "");
+    const char* buffer = view.data();
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        int seconds = 25 * 60 - i % (25 * 60);
+        bytes += view.compose(benchColumns, benchRows, "FOCUS", seconds, 1.0 - seconds / 1500.0, "deep work",
+                              "p pause  f finish  v normal view  q quit");
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frames;
+    std::cout << frames << " frames at " << benchColumns << "x" << benchRows << ": " << std::fixed
+              << std::setprecision(0) << ns << " ns/frame, " << bytes / frames << " bytes/frame, "
+              << (view.data() == buffer ? "no" : "unexpected") << " buffer reallocation" << std::endl;
+    return 0;
+}
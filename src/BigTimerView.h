@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * Full-screen countdown for the CLI, readable across a room.
+ *
+ * The time is drawn in block digits scaled to the terminal size, with a
+ * progress bar for the current phase and one line each for the state and
+ * the key hints. Digit bitmaps are compile-time tables; each frame is
+ * composed into a buffer that is only reallocated when the terminal is
+ * resized (SIGWINCH) and written with a single write() call.
+ */
+class BigTimerView {
+public:
+    BigTimerView();
+    ~BigTimerView();
+
+    BigTimerView(const BigTimerView&) = delete;
+    BigTimerView& operator=(const BigTimerView&) = delete;
+
+    // Switch to the alternate screen and hide the cursor, or restore the normal screen
+    void enter();
+    void leave();
+    bool isActive() const { return active; }
+
+    // Compose and write one frame; progress is clamped to [0, 1]
+    void render(const char* label, int seconds, double progress, const char* tag, const char* hint);
+
+    // Compose a frame for a terminal of the given size without writing it; returns its length
+    size_t compose(int columns, int rows, const char* label, int seconds, double progress,
+                   const char* tag, const char* hint);
+    const char* data() const { return frame.data(); }
+
+private:
+    std::vector<char> frame;
+    std::vector<char> fullRun;
+    std::vector<char> lightRun;
+    size_t length;
+    int columns;
+    int rows;
+    bool active;
+
+    void querySize();
+    void reserveFor(int frameColumns, int frameRows);
+};
+
+// "ADHDPomodoro-CLI bigclock bench [frames=N] [cols=N] [rows=N]"
+int runBigClockCommand(int argc, char* argv[]);
@@ -0,0 +1,533 @@
+#include "BusyCalendar.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include "CLISettings.h"
+#include "SessionLog.h"
+
+namespace {
+
+const char busyMagic[4] = { 'P', 'B', 'S', 'Y' };
+const uint32_t busyVersion = 1;
+const int64_t secondsPerDay = 86400;
+// Recurring events are expanded this far ahead of the import
+const int64_t expansionHorizon = 366 * secondsPerDay;
+const int maxOccurrences = 10000;
+
+// Convert a UTC instant to the local wall-clock seconds used by the log
+int64_t utcToLocal(int64_t utc) {
+    std::time_t time = static_cast<std::time_t>(utc);
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &time);
+#else
+    localtime_r(&time, &local);
+#endif
+    return civilToEpoch(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday, local.tm_hour, local.tm_min,
+                        local.tm_sec);
+}
+
+// "YYYYMMDD" or "YYYYMMDDTHHMMSS[Z]"; TZID parameters are read as local time
+bool parseIcsTime(const std::string& value, int64_t& out, bool& dateOnly) {
+    auto number = [&value](size_t pos, size_t length, int& result) {
+        if (pos + length > value.size()) return false;
+        result = 0;
+        for (size_t i = pos; i < pos + length; ++i) {
+            if (value[i] < '0' || value[i] > '9') return false;
+            result = result * 10 + (value[i] - '0');
+        }
+        return true;
+    };
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (!number(0, 4, year) || !number(4, 2, month) || !number(6, 2, day)) return false;
+    dateOnly = value.size() < 15 || value[8] != 'T';
+    if (!dateOnly && (!number(9, 2, hour) || !number(11, 2, minute) || !number(13, 2, second))) return false;
+    out = civilToEpoch(year, month, day, hour, minute, second);
+    if (!dateOnly && value.size() > 15 && value[15] == 'Z') out = utcToLocal(out);
+    return true;
+}
+
+// "P1W", "PT1H30M", "P1DT2H"
+bool parseIcsDuration(const std::string& value, int64_t& out) {
+    size_t pos = 0;
+    int sign = 1;
+    if (pos < value.size() && (value[pos] == '+' || value[pos] == '-')) sign = value[pos++] == '-' ? -1 : 1;
+    if (pos >= value.size() || value[pos++] != 'P') return false;
+    out = 0;
+    int64_t amount = 0;
+    bool haveDigits = false;
+    for (; pos < value.size(); ++pos) {
+        char c = value[pos];
+        if (c >= '0' && c <= '9') {
+            amount = amount * 10 + (c - '0');
+            haveDigits = true;
+            continue;
+        }
+        if (c == 'T') continue;
+        if (!haveDigits) return false;
+        switch (c) {
+            case 'W': out += amount * 7 * secondsPerDay; break;
+            case 'D': out += amount * secondsPerDay; break;
+            case 'H': out += amount * 3600; break;
+            case 'M': out += amount * 60; break;
+            case 'S': out += amount; break;
+            default: return false;
+        }
+        amount = 0;
+        haveDigits = false;
+    }
+    out *= sign;
+    return true;
+}
+
+// Monday = 0
+int weekday(int64_t epoch) {
+    int64_t day = epoch >= 0 ? epoch / secondsPerDay : (epoch - secondsPerDay + 1) / secondsPerDay;
+    return static_cast<int>(((day + 3) % 7 + 7) % 7);   // 1970-01-01 was a Thursday
+}
+
+struct EventFields {
+    std::string uid;
+    std::string recurrenceId;   // set on an instance that replaces one occurrence of a recurring event
+    std::string start;
+    std::string end;
+    std::string duration;
+    std::string rule;
+    std::vector<std::string> exdates;
+    bool transparent = false;
+    bool cancelled = false;
+    bool zoned = false;         // DTSTART/DTEND carry a TZID
+};
+
+struct ImportCounts {
+    size_t events = 0;
+    size_t skippedAllDay = 0;
+    size_t skippedFree = 0;
+    size_t unsupportedRules = 0;
+    size_t zonedEvents = 0;
+    size_t occurrences = 0;
+};
+
+std::string ruleValue(const std::string& rule, const char* name) {
+    std::string key = std::string(name) + "=";
+    size_t pos = 0;
+    while (pos < rule.size()) {
+        size_t end = rule.find(';', pos);
+        if (end == std::string::npos) end = rule.size();
+        if (rule.compare(pos, key.size(), key) == 0) return rule.substr(pos + key.size(), end - pos - key.size());
+        pos = end + 1;
+    }
+    return std::string();
+}
+
+// Append the busy intervals of one VEVENT that end after notBefore
+void expandEvent(const EventFields& event, int64_t notBefore, int64_t horizon,
+                 std::vector<BusyCalendar::Interval>& out, ImportCounts& counts) {
+    counts.events++;
+    if (event.cancelled) return;
+    if (event.transparent) {
+        counts.skippedFree++;
+        return;
+    }
+    int64_t start, end;
+    bool dateOnly, endDateOnly;
+    if (!parseIcsTime(event.start, start, dateOnly)) return;
+    if (dateOnly) {
+        // All-day entries (holidays, birthdays, OOO markers) do not block focus time
+        counts.skippedAllDay++;
+        return;
+    }
+    if (event.zoned) counts.zonedEvents++;
+    int64_t length = 0;
+    if (!event.end.empty() && parseIcsTime(event.end, end, endDateOnly)) {
+        length = end - start;
+    } else if (!event.duration.empty()) {
+        parseIcsDuration(event.duration, length);
+    }
+    if (length <= 0) return;
+
+    std::set<int64_t> excluded;
+    for (const std::string& list : event.exdates) {
+        std::stringstream values(list);
+        std::string value;
+        while (std::getline(values, value, ',')) {
+            int64_t time;
+            if (parseIcsTime(value, time, endDateOnly)) excluded.insert(time);
+        }
+    }
+
+    size_t before = out.size();
+    auto emit = [&](int64_t occurrence) {
+        if (excluded.count(occurrence) == 0 && occurrence + length > notBefore) {
+            out.push_back(BusyCalendar::Interval{ occurrence, occurrence + length });
+        }
+    };
+
+    if (event.rule.empty()) {
+        emit(start);
+        counts.occurrences += out.size() - before;
+        return;
+    }
+
+    std::string frequency = ruleValue(event.rule, "FREQ");
+    std::string interval = ruleValue(event.rule, "INTERVAL");
+    std::string count = ruleValue(event.rule, "COUNT");
+    std::string untilValue = ruleValue(event.rule, "UNTIL");
+    std::string byDay = ruleValue(event.rule, "BYDAY");
+    int step = interval.empty() ? 1 : std::max(1, std::atoi(interval.c_str()));
+    int remaining = count.empty() ? maxOccurrences : std::min(maxOccurrences, std::atoi(count.c_str()));
+    int64_t until = horizon;
+    int64_t parsedUntil;
+    if (!untilValue.empty() && parseIcsTime(untilValue, parsedUntil, endDateOnly)) {
+        if (endDateOnly) parsedUntil += secondsPerDay - 1;
+        until = std::min(until, parsedUntil);
+    }
+
+    if (frequency == "DAILY" || (frequency == "WEEKLY" && byDay.empty())) {
+        int64_t stride = (frequency == "DAILY" ? 1 : 7) * step * secondsPerDay;
+        for (int64_t occurrence = start; occurrence <= until && remaining > 0; occurrence += stride, --remaining) {
+            emit(occurrence);
+        }
+    } else if (frequency == "WEEKLY") {
+        static const char* const dayNames[7] = { "MO", "TU", "WE", "TH", "FR", "SA", "SU" };
+        bool days[7] = {};
+        for (int d = 0; d < 7; ++d) days[d] = byDay.find(dayNames[d]) != std::string::npos;
+        int64_t weekStart = start - weekday(start) * secondsPerDay;
+        for (; weekStart <= until && remaining > 0; weekStart += 7 * step * secondsPerDay) {
+            for (int d = 0; d < 7 && remaining > 0; ++d) {
+                int64_t occurrence = weekStart + d * secondsPerDay;
+                if (!days[d] || occurrence < start || occurrence > until) continue;
+                emit(occurrence);
+                remaining--;
+            }
+        }
+    } else {
+        // MONTHLY/YEARLY rules: keep the first occurrence only
+        counts.unsupportedRules++;
+        emit(start);
+    }
+    counts.occurrences += out.size() - before;
+}
+
+} // namespace
+
+BusyCalendar::BusyCalendar(const std::string& path) : busyFilePath(path), leaves(0) {
+    load();
+}
+
+void BusyCalendar::clear() {
+    intervals.clear();
+    gapTree.clear();
+    leaves = 0;
+}
+
+void BusyCalendar::assign(std::vector<Interval> busy) {
+    std::sort(busy.begin(), busy.end(), [](const Interval& a, const Interval& b) { return a.start < b.start; });
+    intervals.clear();
+    for (const Interval& interval : busy) {
+        if (!intervals.empty() && interval.start <= intervals.back().end) {
+            intervals.back().end = std::max(intervals.back().end, interval.end);
+        } else {
+            intervals.push_back(interval);
+        }
+    }
+    buildGapTree();
+}
+
+void BusyCalendar::buildGapTree() {
+    leaves = 1;
+    while (leaves < intervals.size()) leaves *= 2;
+    gapTree.assign(2 * leaves, -1);
+    for (size_t i = 0; i < intervals.size(); ++i) {
+        gapTree[leaves + i] = i + 1 < intervals.size() ? intervals[i + 1].start - intervals[i].end : INT64_MAX;
+    }
+    for (size_t node = leaves - 1; node > 0; --node) {
+        gapTree[node] = std::max(gapTree[2 * node], gapTree[2 * node + 1]);
+    }
+}
+
+size_t BusyCalendar::firstEndingAfter(int64_t time) const {
+    return static_cast<size_t>(std::partition_point(intervals.begin(), intervals.end(),
+                                                    [time](const Interval& i) { return i.end <= time; }) -
+                               intervals.begin());
+}
+
+bool BusyCalendar::conflict(int64_t from, int64_t to, Interval& busy) const {
+    size_t index = firstEndingAfter(from);
+    if (index == intervals.size() || intervals[index].start >= to) return false;
+    busy = intervals[index];
+    return true;
+}
+
+size_t BusyCalendar::firstGapAtLeast(size_t node, size_t nodeLo, size_t nodeHi, size_t from, int64_t length) const {
+    if (nodeHi < from || gapTree[node] < length) return SIZE_MAX;
+    if (nodeLo == nodeHi) return nodeLo;
+    size_t mid = (nodeLo + nodeHi) / 2;
+    size_t found = firstGapAtLeast(2 * node, nodeLo, mid, from, length);
+    if (found != SIZE_MAX) return found;
+    return firstGapAtLeast(2 * node + 1, mid + 1, nodeHi, from, length);
+}
+
+int64_t BusyCalendar::nextFreeSlot(int64_t from, int64_t length) const {
+    size_t index = firstEndingAfter(from);
+    if (index == intervals.size() || intervals[index].start >= from + length) return from;
+    // The last interval has an unbounded gap after it, so this always finds one
+    size_t gap = firstGapAtLeast(1, 0, leaves - 1, index, length);
+    return intervals[gap].end;
+}
+
+bool BusyCalendar::importIcs(const std::string& icsPath, std::string& report) {
+    std::ifstream file(icsPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open " << icsPath << std::endl;
+        return false;
+    }
+
+    const int64_t now = localNow();
+    const int64_t notBefore = now - secondsPerDay;
+    std::vector<Interval> busy;
+    ImportCounts counts;
+    std::vector<EventFields> events;
+    EventFields event;
+    bool inEvent = false;
+    int nesting = 0;    // VALARM and other components inside a VEVENT
+
+    auto handle = [&](const std::string& line) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) return;
+        size_t nameEnd = line.find_first_of(";:");
+        std::string name = line.substr(0, nameEnd);
+        std::string parameters = line.substr(nameEnd, colon - nameEnd);
+        std::string value = line.substr(colon + 1);
+        if (name == "BEGIN") {
+            if (value == "VEVENT" && !inEvent) {
+                inEvent = true;
+                nesting = 0;
+                event = EventFields();
+            } else if (inEvent) {
+                nesting++;
+            }
+            return;
+        }
+        if (name == "END") {
+            if (inEvent && nesting > 0) {
+                nesting--;
+            } else if (inEvent && value == "VEVENT") {
+                events.push_back(std::move(event));
+                inEvent = false;
+            }
+            return;
+        }
+        if (!inEvent || nesting > 0) return;
+        if ((name == "DTSTART" || name == "DTEND") && parameters.find("TZID=") != std::string::npos) {
+            event.zoned = true;
+        }
+        if (name == "UID") event.uid = value;
+        else if (name == "RECURRENCE-ID") event.recurrenceId = value;
+        else if (name == "DTSTART") event.start = value;
+        else if (name == "DTEND") event.end = value;
+        else if (name == "DURATION") event.duration = value;
+        else if (name == "RRULE") event.rule = value;
+        else if (name == "EXDATE") event.exdates.push_back(value);
+        else if (name == "TRANSP") event.transparent = value == "TRANSPARENT";
+        else if (name == "STATUS") event.cancelled = value == "CANCELLED";
+    };
+
+    // Unfold continuation lines (leading space or tab) before handling
+    std::string line, logical;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && (line[0] == ' ' || line[0] == '\t')) {
+            logical.append(line, 1, std::string::npos);
+            continue;
+        }
+        if (!logical.empty()) handle(logical);
+        logical = line;
+    }
+    if (!logical.empty()) handle(logical);
+
+    // An instance with a RECURRENCE-ID replaces (or cancels) that occurrence of the event
+    // with the same UID, which may come before or after it in the file
+    std::map<std::string, std::vector<std::string>> overridden;
+    for (const EventFields& fields : events) {
+        if (!fields.recurrenceId.empty()) overridden[fields.uid].push_back(fields.recurrenceId);
+    }
+    for (EventFields& fields : events) {
+        auto it = overridden.find(fields.uid);
+        if (fields.recurrenceId.empty() && it != overridden.end()) {
+            fields.exdates.insert(fields.exdates.end(), it->second.begin(), it->second.end());
+        }
+        expandEvent(fields, notBefore, now + expansionHorizon, busy, counts);
+    }
+
+    assign(std::move(busy));
+
+    std::ostringstream out;
+    out << counts.events << " events, " << counts.occurrences << " busy occurrences from yesterday on, "
+        << intervals.size() << " busy periods after merging";
+    if (counts.skippedAllDay > 0) out << "\n" << counts.skippedAllDay << " all-day events ignored";
+    if (counts.skippedFree > 0) out << "\n" << counts.skippedFree << " events marked free ignored";
+    if (counts.unsupportedRules > 0) {
+        out << "\n" << counts.unsupportedRules << " monthly/yearly recurrences imported as single events";
+    }
+    if (counts.zonedEvents > 0) {
+        out << "\n" << counts.zonedEvents << " events with a TZID read as local time";
+    }
+    report = out.str();
+    return true;
+}
+
+bool BusyCalendar::save() const {
+    std::FILE* file = std::fopen(busyFilePath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not save " << busyFilePath << std::endl;
+        return false;
+    }
+    uint32_t header[2] = { busyVersion, static_cast<uint32_t>(intervals.size()) };
+    std::fwrite(busyMagic, 1, sizeof(busyMagic), file);
+    std::fwrite(header, sizeof(header), 1, file);
+    if (!intervals.empty()) std::fwrite(intervals.data(), sizeof(Interval), intervals.size(), file);
+    std::fclose(file);
+    return true;
+}
+
+void BusyCalendar::load() {
+    std::FILE* file = std::fopen(busyFilePath.c_str(), "rb");
+    if (!file) return;
+    char magic[4];
+    uint32_t header[2];
+    if (std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+        std::memcmp(magic, busyMagic, sizeof(magic)) == 0 &&
+        std::fread(header, sizeof(header), 1, file) == 1 && header[0] == busyVersion) {
+        intervals.resize(header[1]);
+        if (std::fread(intervals.data(), sizeof(Interval), intervals.size(), file) != intervals.size()) {
+            std::cerr << "Error: " << busyFilePath << " is truncated" << std::endl;
+            intervals.clear();
+        }
+    }
+    std::fclose(file);
+    buildGapTree();
+}
+
+namespace {
+
+std::string formatMinutes(int64_t seconds) {
+    return std::to_string(seconds / 60) + " min";
+}
+
+int runCalendarBench(int events) {
+    std::mt19937_64 rng(11);
+    int64_t time = localNow();
+    std::vector<BusyCalendar::Interval> busy;
+    for (int i = 0; i < events; ++i) {
+        time += std::uniform_int_distribution<int64_t>(5, 240)(rng) * 60;
+        int64_t length = std::uniform_int_distribution<int64_t>(15, 90)(rng) * 60;
+        busy.push_back(BusyCalendar::Interval{ time, time + length });
+    }
+    BusyCalendar calendar("");
+    auto start = std::chrono::steady_clock::now();
+    calendar.assign(busy);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const int queries = 100000;
+    int64_t first = busy.front().start;
+    int64_t last = busy.back().end;
+    std::vector<int64_t> probes(queries);
+    for (int64_t& probe : probes) probe = std::uniform_int_distribution<int64_t>(first, last)(rng);
+
+    size_t conflicts = 0;
+    int64_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int64_t probe : probes) {
+        BusyCalendar::Interval hit;
+        conflicts += calendar.conflict(probe, probe + 25 * 60, hit);
+    }
+    double conflictNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / queries;
+    start = std::chrono::steady_clock::now();
+    for (int64_t probe : probes) checksum += calendar.nextFreeSlot(probe, 120 * 60) - probe;
+    double slotNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / queries;
+
+    std::cout << events << " events -> " << calendar.size() << " busy periods, built in " << std::fixed
+              << std::setprecision(1) << buildMs << " ms\n"
+              << "conflict query: " << conflictNs << " ns (" << conflicts << " of " << queries << " overlapped)\n"
+              << "next 2 h free slot: " << slotNs << " ns (average wait " << checksum / queries / 60 << " min)"
+              << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int runCalendarCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI calendar import FILE.ics\n"
+        "       ADHDPomodoro-CLI calendar show [days=7]\n"
+        "       ADHDPomodoro-CLI calendar clear\n"
+        "       ADHDPomodoro-CLI calendar bench [events=50000]";
+    std::string action = argc > 2 ? argv[2] : "";
+
+    if (action == "import" && argc == 4) {
+        BusyCalendar calendar;
+        std::string report;
+        if (!calendar.importIcs(argv[3], report) || !calendar.save()) return 1;
+        std::cout << report << std::endl;
+        return 0;
+    }
+    if (action == "clear" && argc == 3) {
+        BusyCalendar calendar;
+        calendar.clear();
+        return calendar.save() ? 0 : 1;
+    }
+
+    int days = 7;
+    int events = 50000;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "days" && parseOptionValue(value, days)) {
+            days = std::max(1, days);
+        } else if (key == "events" && parseOptionValue(value, events)) {
+            events = std::max(1, events);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+    if (action == "bench") {
+        return runCalendarBench(events);
+    }
+    if (action != "show") {
+        std::cerr << usage << std::endl;
+        return 1;
+    }
+
+    BusyCalendar calendar;
+    int64_t now = localNow();
+    int64_t until = now + static_cast<int64_t>(days) * secondsPerDay;
+    size_t shown = 0;
+    for (const BusyCalendar::Interval& busy : calendar.getIntervals()) {
+        if (busy.end <= now || busy.start >= until) continue;
+        std::cout << formatEpoch(busy.start).substr(0, 16) << " - " << formatEpoch(busy.end).substr(11, 5)
+                  << "  (" << formatMinutes(busy.end - busy.start) << ")\n";
+        shown++;
+    }
+    if (shown == 0) {
+        std::cout << "No busy periods in the next " << days << " days\n";
+    }
+    CLISettings settings(false);
+    int64_t length = (settings.getFocusDuration() + settings.getRestDuration()) * 60;
+    std::cout << "Next free " << formatMinutes(length) << " Focus+Rest slot: "
+              << formatEpoch(calendar.nextFreeSlot(now, length)).substr(0, 16) << std::endl;
+    return 0;
+}
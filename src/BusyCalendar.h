@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Busy periods imported from a local iCalendar (.ics) file.
+ *
+ * Opaque, non-cancelled timed events (recurring DAILY/WEEKLY rules are
+ * expanded up to a year ahead, and an instance with a RECURRENCE-ID
+ * replaces the occurrence it overrides) are merged into disjoint sorted intervals
+ * and stored in busy.bin. Because the intervals are disjoint, the one
+ * overlapping a time range is found by binary search, and a max-gap
+ * segment tree over the free gaps between them finds the next free slot
+ * of a given length; both are O(log n).
+ */
+class BusyCalendar {
+public:
+    struct Interval {
+        int64_t start;      // local wall-clock seconds, as in the session log
+        int64_t end;
+    };
+
+    explicit BusyCalendar(const std::string& path = "busy.bin");
+
+    // Replace the busy periods with the events of an .ics file; false if it cannot be read
+    bool importIcs(const std::string& icsPath, std::string& report);
+    bool save() const;
+    void clear();
+
+    size_t size() const { return intervals.size(); }
+    const std::vector<Interval>& getIntervals() const { return intervals; }
+
+    // First busy interval overlapping [from, to)
+    bool conflict(int64_t from, int64_t to, Interval& busy) const;
+    // Earliest time >= from at which length seconds are free
+    int64_t nextFreeSlot(int64_t from, int64_t length) const;
+
+    // Build from arbitrary (possibly overlapping) intervals
+    void assign(std::vector<Interval> busy);
+
+private:
+    std::string busyFilePath;
+    std::vector<Interval> intervals;    // sorted, disjoint
+    std::vector<int64_t> gapTree;       // max free gap after each interval, segment tree
+    size_t leaves;
+
+    void load();
+    void buildGapTree();
+    // Index of the first interval that ends after time
+    size_t firstEndingAfter(int64_t time) const;
+    size_t firstGapAtLeast(size_t node, size_t nodeLo, size_t nodeHi, size_t from, int64_t length) const;
+};
+
+// "ADHDPomodoro-CLI calendar import FILE.ics | show [days=N] | clear | bench [events=N]"
+int runCalendarCommand(int argc, char* argv[]);
@@ -2,7 +2,7 @@
 #include <iostream>
 #include <fstream>
 
-CLISettings::CLISettings() : focusDuration(10), restDuration(5) {
+CLISettings::CLISettings(bool verbose) : focusDuration(10), restDuration(5), verbose(verbose) {
     settingsFilePath = "settings.txt";
     loadSettings();
 }
@@ -12,9 +12,9 @@ void CLISettings::loadSettings() {
     if (settingsFile.is_open()) {
         settingsFile >> focusDuration >> restDuration;
         settingsFile.close();
-        std::cout << "Settings loaded: Focus=" << focusDuration << "min, Rest=" << restDuration << "min" << std::endl;
+        if (verbose) std::cout << "Settings loaded: Focus=" << focusDuration << "min, Rest=" << restDuration << "min" << std::endl;
     } else {
-        std::cout << "No settings file found. Using defaults: Focus=" << focusDuration << "min, Rest=" << restDuration << "min" << std::endl;
+        if (verbose) std::cout << "No settings file found. Using defaults: Focus=" << focusDuration << "min, Rest=" << restDuration << "min" << std::endl;
         saveSettings();
     }
 }
@@ -24,7 +24,7 @@ void CLISettings::saveSettings() {
     if (settingsFile.is_open()) {
         settingsFile << focusDuration << " " << restDuration;
         settingsFile.close();
-        std::cout << "Settings saved: Focus=" << focusDuration << "min, Rest=" << restDuration << "min" << std::endl;
+        if (verbose) std::cout << "Settings saved: Focus=" << focusDuration << "min, Rest=" << restDuration << "min" << std::endl;
     } else {
         std::cerr << "Error: Could not save settings file" << std::endl;
     }
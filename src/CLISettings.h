@@ -4,7 +4,7 @@
 
 class CLISettings {
 public:
-    CLISettings();
+    explicit CLISettings(bool verbose = true);
     void loadSettings();
     void saveSettings();
     
@@ -15,9 +15,12 @@ public:
     void decreaseFocusDuration() { if (focusDuration > 1) focusDuration--; }
     void increaseRestDuration() { if (restDuration < 60) restDuration++; }
     void decreaseRestDuration() { if (restDuration > 1) restDuration--; }
+    void setFocusDuration(int minutes) { focusDuration = minutes < 1 ? 1 : (minutes > 120 ? 120 : minutes); }
+    void setRestDuration(int minutes) { restDuration = minutes < 1 ? 1 : (minutes > 60 ? 60 : minutes); }
     
 private:
     int focusDuration;  // in minutes
     int restDuration;   // in minutes
     std::string settingsFilePath;
+    bool verbose;       // report loading/saving on stdout
 };
\ No newline at end of file
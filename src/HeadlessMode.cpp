@@ -0,0 +1,446 @@
+#include "HeadlessMode.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CLISettings.h"
+#include "LogArchive.h"
+#include "PomodoroManager.h"
+#include "SessionHistory.h"
+
+#ifndef _WIN32
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct Command {
+    std::string name;
+    std::string arg;
+    long number = 0;
+    bool hasNumber = false;
+};
+
+void skipSpace(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+}
+
+bool parseJsonString(const char*& p, const char* end, std::string& out) {
+    if (p >= end || *p != '"') return false;
+    ++p;
+    out.clear();
+    while (p < end && *p != '"') {
+        char c = *p++;
+        if (c == '\\' && p < end) {
+            char e = *p++;
+            switch (e) {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'u':
+                    // Only ASCII escapes are meaningful for commands
+                    if (end - p >= 4) {
+                        out.push_back(static_cast<char>(std::strtol(std::string(p, 4).c_str(), nullptr, 16) & 0x7F));
+                        p += 4;
+                    }
+                    break;
+                default: out.push_back(e); break;
+            }
+        } else {
+            out.push_back(c);
+        }
+    }
+    if (p >= end) return false;
+    ++p;
+    return true;
+}
+
+// Words separated by spaces: name [arg] [number]
+void parseWords(const std::string& text, Command& out) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    std::string words[3];
+    int count = 0;
+    while (count < 3) {
+        skipSpace(p, end);
+        if (p >= end) break;
+        const char* start = p;
+        while (p < end && *p != ' ' && *p != '\t') ++p;
+        words[count++].assign(start, p);
+    }
+    out.name = words[0];
+    for (int i = 1; i < count; ++i) {
+        char* numberEnd = nullptr;
+        long number = std::strtol(words[i].c_str(), &numberEnd, 10);
+        if (!words[i].empty() && *numberEnd == '\0') {
+            out.number = number;
+            out.hasNumber = true;
+        } else if (out.arg.empty()) {
+            out.arg = words[i];
+        }
+    }
+    if (count == 3 && out.name == "start") {
+        // Tags may contain spaces
+        size_t tagStart = text.find(words[1]);
+        out.arg = text.substr(tagStart);
+        out.hasNumber = false;
+    }
+}
+
+bool parseCommand(const char* line, size_t length, Command& out) {
+    const char* p = line;
+    const char* end = line + length;
+    skipSpace(p, end);
+    while (end > p && (end[-1] == ' ' || end[-1] == '\r' || end[-1] == '\t')) --end;
+    if (p >= end) return false;
+
+    if (*p == '"') {
+        std::string text;
+        if (!parseJsonString(p, end, text)) return false;
+        parseWords(text, out);
+        return !out.name.empty();
+    }
+    if (*p != '{') {
+        parseWords(std::string(p, end), out);
+        return !out.name.empty();
+    }
+
+    // Flat JSON object with string, number or literal values
+    ++p;
+    std::string key, value;
+    while (true) {
+        skipSpace(p, end);
+        if (p < end && *p == '}') break;
+        if (!parseJsonString(p, end, key)) return false;
+        skipSpace(p, end);
+        if (p >= end || *p != ':') return false;
+        ++p;
+        skipSpace(p, end);
+        if (p >= end) return false;
+
+        if (*p == '"') {
+            if (!parseJsonString(p, end, value)) return false;
+            if (key == "cmd" || key == "command") out.name = value;
+            else out.arg = value;
+        } else {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ' ') ++p;
+            value.assign(start, p);
+            char* numberEnd = nullptr;
+            long number = std::strtol(value.c_str(), &numberEnd, 10);
+            if (!value.empty() && *numberEnd == '\0') {
+                out.number = number;
+                out.hasNumber = true;
+                if (key == "focus" || key == "rest") out.arg = key;
+            }
+        }
+        skipSpace(p, end);
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+        if (p < end && *p == '}') break;
+        return false;
+    }
+    return !out.name.empty();
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out.push_back('"');
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+class HeadlessSession {
+public:
+    HeadlessSession(SessionLogger& logger, SessionHistory* history, CLISettings& settings)
+        : logger(logger), history(history), settings(settings),
+          timer(logger, settings.getFocusDuration(), settings.getRestDuration()),
+          virtualOffset(0), lastState(timer.getState()), lastRunning(false), lastPaused(false),
+          sequence(0), quitRequested(false) {
+        output.reserve(outputLimit);
+    }
+
+    bool quit() const { return quitRequested; }
+
+    void handleLine(const char* line, size_t length) {
+        Command command;
+        if (!parseCommand(line, length, command)) {
+            if (length > 0) error("parse", "could not parse command");
+            return;
+        }
+        PomodoroManager::TimePoint current = now();
+        timer.update(current);
+        emitIfChanged("tick");
+
+        const std::string& name = command.name;
+        bool applied = true;
+        if (name == "start") {
+            if (!timer.isRunning()) {
+                uint32_t tag = 0;
+                if (!command.arg.empty()) tag = history ? history->tags.intern(command.arg) : 0;
+                logger.setTag(tag);
+                tagName = command.arg;
+            }
+            applied = timer.start(current);
+        } else if (name == "pause") {
+            applied = timer.isRunning() && !timer.isPausedNow() && timer.togglePause(current);
+        } else if (name == "resume") {
+            applied = timer.isRunning() && timer.isPausedNow() && timer.togglePause(current);
+        } else if (name == "finish") {
+            applied = timer.isRunning() && timer.getState() != State::Rest &&
+                      timer.getState() != State::IdleAfterRest && timer.finish(current);
+        } else if (name == "focus") {
+            applied = (timer.getState() == State::Rest || timer.getState() == State::IdleAfterRest) &&
+                      timer.finish(current);
+        } else if (name == "rate") {
+            Rating rating = Rating::None;
+            if (command.arg == "good" || command.arg == "g") rating = Rating::Good;
+            else if (command.arg == "bad" || command.arg == "b") rating = Rating::Bad;
+            else if (command.arg == "okay" || command.arg == "o") rating = Rating::Okay;
+            if (rating == Rating::None) {
+                error(name, "rating must be good, bad or okay");
+                return;
+            }
+            applied = timer.rate(rating, current);
+        } else if (name == "hyperfocus") {
+            applied = timer.enterHyperfocus();
+        } else if (name == "rest") {
+            applied = timer.rest(current);
+        } else if (name == "status") {
+            emitState("status", name);
+            return;
+        } else if (name == "set") {
+            if (!command.hasNumber || (command.arg != "focus" && command.arg != "rest")) {
+                error(name, "usage: set focus|rest MINUTES");
+                return;
+            }
+            if (command.arg == "focus") settings.setFocusDuration(static_cast<int>(command.number));
+            else settings.setRestDuration(static_cast<int>(command.number));
+            timer.setFocusDuration(settings.getFocusDuration());
+            timer.setRestDuration(settings.getRestDuration());
+            emitSettings();
+            return;
+        } else if (name == "save") {
+            settings.saveSettings();
+            emitSettings();
+            return;
+        } else if (name == "advance") {
+            if (!command.hasNumber || command.number < 0) {
+                error(name, "usage: advance SECONDS");
+                return;
+            }
+            virtualOffset += std::chrono::seconds(command.number);
+            timer.update(now());
+            emitIfChanged(name);
+            return;
+        } else if (name == "quit") {
+            logger.log(LogEvent::Quit);
+            quitRequested = true;
+            return;
+        } else {
+            error(name, "unknown command");
+            return;
+        }
+
+        if (!applied) {
+            error(name, std::string("not applicable in state ") + describeState());
+            return;
+        }
+        emitIfChanged(name);
+    }
+
+    // Periodic update while no input arrives
+    void tick() {
+        timer.update(now());
+        emitIfChanged("tick");
+    }
+
+    void flush() {
+        if (output.empty()) return;
+        std::fwrite(output.data(), 1, output.size(), stdout);
+        std::fflush(stdout);
+        output.clear();
+    }
+
+private:
+    static const size_t outputLimit = 1 << 16;
+
+    SessionLogger& logger;
+    SessionHistory* history;
+    CLISettings& settings;
+    PomodoroManager timer;
+    PomodoroManager::Clock::duration virtualOffset;
+
+    State lastState;
+    bool lastRunning;
+    bool lastPaused;
+    uint64_t sequence;
+    bool quitRequested;
+    std::string tagName;
+    std::string output;
+
+    PomodoroManager::TimePoint now() const {
+        return PomodoroManager::Clock::now() + virtualOffset;
+    }
+
+    std::string describeState() const {
+        if (!timer.isRunning()) return "stopped";
+        return timer.isPausedNow() ? std::string("paused ") + stateName(timer.getState()) : stateName(timer.getState());
+    }
+
+    void beginEvent(const char* event) {
+        char head[64];
+        std::snprintf(head, sizeof(head), "{\"seq\":%llu,\"event\":\"%s\"",
+                      static_cast<unsigned long long>(++sequence), event);
+        output += head;
+    }
+
+    void endEvent() {
+        output += "}\n";
+        if (output.size() >= outputLimit) flush();
+    }
+
+    void emitState(const char* event, const std::string& command) {
+        int remaining = 0;
+        if (timer.getState() == State::Focus) remaining = timer.getFocusDuration() * 60 - timer.getElapsedSeconds();
+        if (timer.getState() == State::Rest) remaining = timer.getRestDuration() * 60 - timer.getElapsedSeconds();
+
+        beginEvent(event);
+        output += ",\"command\":";
+        appendJsonString(output, command);
+        char fields[256];
+        std::snprintf(fields, sizeof(fields),
+                      ",\"state\":\"%s\",\"running\":%s,\"paused\":%s,\"elapsed\":%d,\"remaining\":%d,\"total_focus\":%d",
+                      stateName(timer.getState()), timer.isRunning() ? "true" : "false",
+                      timer.isPausedNow() ? "true" : "false", timer.getElapsedSeconds(),
+                      remaining > 0 ? remaining : 0, timer.getTotalFocusTime());
+        output += fields;
+        output += ",\"tag\":";
+        appendJsonString(output, timer.isRunning() ? tagName : std::string());
+        endEvent();
+    }
+
+    void emitIfChanged(const std::string& command) {
+        if (timer.getState() == lastState && timer.isRunning() == lastRunning && timer.isPausedNow() == lastPaused) {
+            return;
+        }
+        lastState = timer.getState();
+        lastRunning = timer.isRunning();
+        lastPaused = timer.isPausedNow();
+        emitState("state", command);
+    }
+
+    void emitSettings() {
+        beginEvent("settings");
+        char fields[64];
+        std::snprintf(fields, sizeof(fields), ",\"focus\":%d,\"rest\":%d",
+                      settings.getFocusDuration(), settings.getRestDuration());
+        output += fields;
+        endEvent();
+    }
+
+    void error(const std::string& command, const std::string& message) {
+        beginEvent("error");
+        output += ",\"command\":";
+        appendJsonString(output, command);
+        output += ",\"message\":";
+        appendJsonString(output, message);
+        endEvent();
+    }
+};
+
+} // namespace
+
+int runHeadless(int argc, char* argv[]) {
+    std::string logPath = "log.txt";
+    bool customLog = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--log" && i + 1 < argc) {
+            logPath = argv[++i];
+            customLog = true;
+        } else {
+            std::cerr << "Usage: ADHDPomodoro-CLI --headless [--log FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    CLISettings settings(false);
+    SessionLogger logger(logPath);
+    // Derived history, log rotation (rotation.txt) and background compaction of sealed segments
+    // only follow the real log; a custom log (e.g. for load tests) is written alone
+    std::unique_ptr<SessionHistory> history;
+    std::unique_ptr<LogArchiver> archiver;
+    if (!customLog) {
+        history = std::make_unique<SessionHistory>();
+        history->attach(logger);
+        archiver = std::make_unique<LogArchiver>();
+        archiver->attach(logger);
+    }
+    HeadlessSession session(logger, history.get(), settings);
+
+#ifdef _WIN32
+    std::string line;
+    while (!session.quit() && std::getline(std::cin, line)) {
+        session.handleLine(line.data(), line.size());
+        session.flush();
+    }
+#else
+    std::string pending;
+    std::vector<char> buffer(1 << 16);
+    while (!session.quit()) {
+        // Handle every complete line already received
+        size_t begin = 0;
+        size_t newline;
+        while (!session.quit() && (newline = pending.find('\n', begin)) != std::string::npos) {
+            session.handleLine(pending.data() + begin, newline - begin);
+            begin = newline + 1;
+        }
+        pending.erase(0, begin);
+        session.flush();
+        if (session.quit()) break;
+
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(STDIN_FILENO, &readSet);
+        struct timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = 250000;
+        int ready = select(STDIN_FILENO + 1, &readSet, NULL, NULL, &timeout);
+        if (ready > 0) {
+            ssize_t bytesRead = read(STDIN_FILENO, buffer.data(), buffer.size());
+            if (bytesRead <= 0) {
+                if (!pending.empty()) session.handleLine(pending.data(), pending.size());
+                break;
+            }
+            pending.append(buffer.data(), static_cast<size_t>(bytesRead));
+        } else if (ready == 0) {
+            session.tick();
+        }
+    }
+#endif
+    session.flush();
+    logger.close();
+    return 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * Headless control protocol for scripted use and load testing.
+ *
+ * Reads one command per line on stdin, either as a JSON object
+ *   {"cmd":"start","tag":"oncall"}  {"cmd":"rate","rating":"good"}
+ *   {"cmd":"set","focus":25}        {"cmd":"advance","seconds":600}
+ * or as a JSON string / bare text with the same words ("rate good").
+ * Commands: start [tag], pause, resume, finish, focus, rate good|bad|okay,
+ * hyperfocus, rest, status, set focus|rest N, advance N, save, quit.
+ *
+ * Writes one JSON object per line on stdout: "state" events whenever the
+ * timer state changes (including automatic transitions), "status" replies,
+ * "settings" replies and "error" events. Nothing else is printed.
+ */
+
+// "ADHDPomodoro-CLI --headless [--log FILE]"
+int runHeadless(int argc, char* argv[]);
@@ -0,0 +1,87 @@
+#include "HeatmapPanel.h"
+
+namespace {
+
+const int weeks = 53;
+const int daysPerWeek = 7;
+const float cellSize = 4.f;
+const float cellPitch = 5.f;
+const float padding = 6.f;
+const float labelHeight = 22.f;
+
+sf::Color cellColor(uint32_t focusMinutes) {
+    if (focusMinutes == 0) return sf::Color(235, 235, 235);
+    if (focusMinutes < 30) return sf::Color(198, 228, 139);
+    if (focusMinutes < 60) return sf::Color(123, 201, 111);
+    if (focusMinutes < 120) return sf::Color(35, 154, 59);
+    return sf::Color(25, 97, 39);
+}
+
+} // namespace
+
+HeatmapPanel::HeatmapPanel(const RollupStore& rollups)
+    : rollups(rollups), cells(sf::Quads, weeks * daysPerWeek * 4),
+      visible(false), dirty(true), rebuildAt(0) {}
+
+float HeatmapPanel::getHeight() const {
+    return labelHeight + daysPerWeek * cellPitch + 8.f;
+}
+
+void HeatmapPanel::rebuild(const sf::Font& font) {
+    const int64_t now = localNow();
+    const int32_t today = epochDay(now);
+    // Day 0 (1970-01-01) was a Thursday; column 0 starts on the Monday 52 weeks back
+    const int32_t todayWeekday = (today + 3) % 7;
+    const int32_t firstDay = today - todayWeekday - (weeks - 1) * daysPerWeek;
+
+    std::vector<RollupSlot> days = rollups.range(RollupResolution::Day,
+                                                 static_cast<int64_t>(firstDay) * 86400,
+                                                 static_cast<int64_t>(today + 1) * 86400);
+
+    uint32_t totalMinutes = 0;
+    for (int week = 0; week < weeks; ++week) {
+        for (int weekday = 0; weekday < daysPerWeek; ++weekday) {
+            const size_t index = static_cast<size_t>(week * daysPerWeek + weekday);
+            sf::Vertex* quad = &cells[index * 4];
+
+            sf::Color color = sf::Color::Transparent;
+            if (index < days.size()) {
+                uint32_t minutes = (days[index].focusSeconds + days[index].hyperfocusSeconds) / 60;
+                // The grid starts on a Monday up to 371 days back; the total covers 365
+                if (firstDay + static_cast<int32_t>(index) > today - 365) totalMinutes += minutes;
+                color = cellColor(minutes);
+            }
+
+            const float x = padding + week * cellPitch;
+            const float y = labelHeight + weekday * cellPitch;
+            quad[0].position = sf::Vector2f(x, y);
+            quad[1].position = sf::Vector2f(x + cellSize, y);
+            quad[2].position = sf::Vector2f(x + cellSize, y + cellSize);
+            quad[3].position = sf::Vector2f(x, y + cellSize);
+            for (int corner = 0; corner < 4; ++corner) {
+                quad[corner].color = color;
+            }
+        }
+    }
+
+    summaryText.setFont(font);
+    summaryText.setCharacterSize(12);
+    summaryText.setFillColor(sf::Color(50, 50, 50));
+    summaryText.setString("Focus, last 365 days: " + std::to_string(totalMinutes / 60) + " h");
+
+    rebuildAt = std::time(nullptr) + (86400 - now % 86400);
+    dirty = false;
+}
+
+void HeatmapPanel::draw(sf::RenderTarget& target, const sf::Font& font, float top) {
+    if (!visible) return;
+    if (dirty || std::time(nullptr) >= rebuildAt) {
+        rebuild(font);
+    }
+
+    sf::RenderStates states;
+    states.transform.translate(0.f, top);
+    summaryText.setPosition(padding, top + 3.f);
+    target.draw(summaryText);
+    target.draw(cells, states);
+}
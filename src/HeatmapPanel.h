@@ -0,0 +1,36 @@
+#pragma once
+#include <ctime>
+#include <SFML/Graphics.hpp>
+#include "Rollups.h"
+
+/**
+ * Toggleable panel below the timer showing daily focus minutes for the
+ * last year (one column per week, one row per weekday).
+ *
+ * All cells live in a single quad vertex array that is only rebuilt from
+ * the day rollup when a session ends or the date changes, so drawing the
+ * panel costs one draw call per frame.
+ */
+class HeatmapPanel {
+public:
+    explicit HeatmapPanel(const RollupStore& rollups);
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+    float getHeight() const;
+
+    // Call when new focus time has been logged
+    void markDirty() { dirty = true; }
+
+    void draw(sf::RenderTarget& target, const sf::Font& font, float top);
+
+private:
+    const RollupStore& rollups;
+    sf::VertexArray cells;
+    sf::Text summaryText;
+    bool visible;
+    bool dirty;
+    std::time_t rebuildAt;   // next local midnight
+
+    void rebuild(const sf::Font& font);
+};
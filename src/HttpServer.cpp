@@ -0,0 +1,828 @@
+#include "HttpServer.h"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "LogArchive.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t maxHeaderBytes = 16 * 1024;
+const size_t maxBodyBytes = 64 * 1024;     // larger request bodies are not read; the connection closes
+const size_t maxCachedResponses = 256;
+
+void appendJsonString(std::string& out, const char* text) {
+    out.push_back('"');
+    for (const char* p = text; *p; ++p) {
+        char c = *p;
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+const char* ratingKey(Rating rating) {
+    switch (rating) {
+        case Rating::Good: return "good";
+        case Rating::Bad: return "bad";
+        case Rating::Okay: return "okay";
+        default: return "";
+    }
+}
+
+bool isBlockEvent(LogEvent event) {
+    return event == LogEvent::Focus || event == LogEvent::Hyperfocus ||
+           event == LogEvent::Rest || event == LogEvent::Idle;
+}
+
+// Value of name=... in a query string
+std::string queryValue(const std::string& query, const char* name) {
+    size_t length = std::strlen(name);
+    size_t pos = 0;
+    while (pos < query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string::npos) end = query.size();
+        if (end - pos > length && query.compare(pos, length, name) == 0 && query[pos + length] == '=') {
+            return query.substr(pos + length + 1, end - pos - length - 1);
+        }
+        pos = end + 1;
+    }
+    return std::string();
+}
+
+bool equalsIgnoreCase(const char* a, size_t length, const char* b) {
+    if (std::strlen(b) != length) return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != b[i]) return false;
+    }
+    return true;
+}
+
+void appendResponse(std::string& out, int code, const char* reason, const std::string& etag,
+                    const std::string& body, bool sendBody, bool keepAlive) {
+    char head[256];
+    int length = std::snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\nConnection: %s\r\n", code, reason,
+                               keepAlive ? "keep-alive" : "close");
+    out.append(head, static_cast<size_t>(length));
+    if (!etag.empty()) {
+        out += "ETag: ";
+        out += etag;
+        out += "\r\nCache-Control: no-cache\r\n";
+    }
+    if (code != 304) {
+        length = std::snprintf(head, sizeof(head), "Content-Type: application/json\r\nContent-Length: %zu\r\n",
+                               body.size());
+        out.append(head, static_cast<size_t>(length));
+    }
+    out += "\r\n";
+    if (sendBody && code != 304) out += body;
+}
+
+} // namespace
+
+void StatusBoard::publish(const TimerStatus& status) {
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+    bool changed = status.available != current.available || status.state != current.state ||
+                   status.running != current.running || status.paused != current.paused ||
+                   status.elapsedSeconds != current.elapsedSeconds ||
+                   status.remainingSeconds != current.remainingSeconds ||
+                   status.totalFocusSeconds != current.totalFocusSeconds ||
+                   status.focusMinutes != current.focusMinutes || status.restMinutes != current.restMinutes ||
+                   std::strncmp(status.tag, current.tag, sizeof(status.tag)) != 0;
+    if (!changed) return;
+    current = status;
+    current.tag[sizeof(current.tag) - 1] = '\0';
+    version++;
+}
+
+uint64_t StatusBoard::read(TimerStatus& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out = current;
+    return version;
+}
+
+HttpServer::HttpServer(StatusBoard& board, const std::string& logPath)
+    : board(board), logFilePath(logPath), listenFd(-1), epollFd(-1), wakeFd(-1), port(0), stopping(false),
+      logInode(UINT64_MAX), logOffset(0), sealedRecords(0), statusVersion(UINT64_MAX) {}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+std::string HttpServer::statusJson(const TimerStatus& status) const {
+    std::string body;
+    char fields[320];
+    std::snprintf(fields, sizeof(fields),
+                  "{\"available\":%s,\"state\":\"%s\",\"running\":%s,\"paused\":%s,\"elapsed\":%d,"
+                  "\"remaining\":%d,\"total_focus\":%d,\"focus_minutes\":%d,\"rest_minutes\":%d,\"tag\":",
+                  status.available ? "true" : "false", stateName(status.state), status.running ? "true" : "false",
+                  status.paused ? "true" : "false", status.elapsedSeconds, status.remainingSeconds,
+                  status.totalFocusSeconds, status.focusMinutes, status.restMinutes);
+    body += fields;
+    appendJsonString(body, status.tag);
+    body += "}";
+    return body;
+}
+
+std::string HttpServer::todayJson(int32_t day) {
+    const int64_t dayStart = static_cast<int64_t>(day) * 86400;
+    auto first = std::lower_bound(blocks.begin(), blocks.end(), dayStart,
+                                  [](const Block& block, int64_t time) { return block.end < time; });
+    uint32_t minutes[static_cast<size_t>(LogEvent::Count)] = {};
+    uint32_t ratings[static_cast<size_t>(Rating::Count)] = {};
+    uint32_t sessions = 0;
+    for (auto it = first; it != blocks.end() && it->end < dayStart + 86400; ++it) {
+        minutes[static_cast<size_t>(it->event)] += it->minutes;
+        ratings[static_cast<size_t>(it->rating)]++;
+        if (it->event == LogEvent::Focus || it->event == LogEvent::Hyperfocus) sessions++;
+    }
+
+    std::string date = formatEpoch(dayStart).substr(0, 10);
+    char body[384];
+    std::snprintf(body, sizeof(body),
+                  "{\"date\":\"%s\",\"focus_minutes\":%u,\"hyperfocus_minutes\":%u,\"rest_minutes\":%u,"
+                  "\"idle_minutes\":%u,\"sessions\":%u,\"good\":%u,\"bad\":%u,\"okay\":%u}",
+                  date.c_str(), minutes[static_cast<size_t>(LogEvent::Focus)],
+                  minutes[static_cast<size_t>(LogEvent::Hyperfocus)], minutes[static_cast<size_t>(LogEvent::Rest)],
+                  minutes[static_cast<size_t>(LogEvent::Idle)], sessions,
+                  ratings[static_cast<size_t>(Rating::Good)], ratings[static_cast<size_t>(Rating::Bad)],
+                  ratings[static_cast<size_t>(Rating::Okay)]);
+    return body;
+}
+
+std::string HttpServer::sessionsJson(int32_t fromDay, int32_t toDay) {
+    const int64_t from = static_cast<int64_t>(fromDay) * 86400;
+    const int64_t to = toDay == INT32_MAX ? INT64_MAX : (static_cast<int64_t>(toDay) + 1) * 86400;
+    auto first = std::lower_bound(blocks.begin(), blocks.end(), from,
+                                  [](const Block& block, int64_t time) { return block.end < time; });
+    auto last = std::lower_bound(first, blocks.end(), to,
+                                 [](const Block& block, int64_t time) { return block.end < time; });
+
+    std::string body;
+    body.reserve(static_cast<size_t>(last - first) * 120 + 32);
+    char count[48];
+    std::snprintf(count, sizeof(count), "{\"count\":%zu,\"sessions\":[", static_cast<size_t>(last - first));
+    body += count;
+    char fields[160];
+    for (auto it = first; it != last; ++it) {
+        std::snprintf(fields, sizeof(fields), "%s{\"start\":\"%s\",\"end\":\"%s\",\"state\":\"%s\",\"minutes\":%u,"
+                      "\"rating\":\"%s\",\"tag\":",
+                      it == first ? "" : ",", formatEpoch(it->end - static_cast<int64_t>(it->minutes) * 60).c_str(),
+                      formatEpoch(it->end).c_str(), eventName(it->event), it->minutes, ratingKey(it->rating));
+        body += fields;
+        appendJsonString(body, tags->name(it->tagId).c_str());
+        body += "}";
+    }
+    body += "]}";
+    return body;
+}
+
+void HttpServer::respond(Connection& connection, const std::string& method, const std::string& target,
+                         const std::string& ifNoneMatch) {
+    bool keepAlive = !connection.closeAfterWrite;
+    if (method != "GET" && method != "HEAD") {
+        appendResponse(connection.output, 405, "Method Not Allowed", "", "{\"error\":\"method not allowed\"}",
+                       true, keepAlive);
+        return;
+    }
+    bool sendBody = method == "GET";
+    size_t question = target.find('?');
+    std::string path = target.substr(0, question);
+    std::string query = question == std::string::npos ? "" : target.substr(question + 1);
+
+    char etag[48];
+    if (path == "/status") {
+        TimerStatus status;
+        uint64_t version = board.read(status);
+        if (version != statusVersion) {
+            statusBody = statusJson(status);
+            statusVersion = version;
+        }
+        std::snprintf(etag, sizeof(etag), "\"s%llu\"", static_cast<unsigned long long>(version));
+        bool fresh = ifNoneMatch == etag;
+        appendResponse(connection.output, fresh ? 304 : 200, fresh ? "Not Modified" : "OK", etag, statusBody,
+                       sendBody, keepAlive);
+        return;
+    }
+
+    int32_t today = epochDay(localNow());
+    std::string cacheKey;
+    int32_t fromDay = INT32_MIN;
+    int32_t toDay = INT32_MAX;
+    if (path == "/today") {
+        // The answer changes at midnight even if the log does not
+        cacheKey = "/today@" + std::to_string(today);
+        std::snprintf(etag, sizeof(etag), "\"%llu-%llu-%d\"", static_cast<unsigned long long>(sealedRecords),
+                      static_cast<unsigned long long>(logOffset), today);
+    } else if (path == "/sessions") {
+        int64_t epoch;
+        std::string from = queryValue(query, "from");
+        std::string to = queryValue(query, "to");
+        if ((!from.empty() && !parseEpoch(from.data(), from.size(), epoch)) ||
+            (!to.empty() && !parseEpoch(to.data(), to.size(), epoch))) {
+            appendResponse(connection.output, 400, "Bad Request", "",
+                           "{\"error\":\"from/to must be YYYY-MM-DD\"}", sendBody, keepAlive);
+            return;
+        }
+        if (!from.empty() && parseEpoch(from.data(), from.size(), epoch)) fromDay = epochDay(epoch);
+        if (!to.empty() && parseEpoch(to.data(), to.size(), epoch)) toDay = epochDay(epoch);
+        // Only the parsed range matters, so "?to=..&from=.." and extra parameters share an entry
+        cacheKey = "/sessions@" + std::to_string(fromDay) + ".." + std::to_string(toDay);
+        std::snprintf(etag, sizeof(etag), "\"%llu-%llu\"", static_cast<unsigned long long>(sealedRecords),
+                      static_cast<unsigned long long>(logOffset));
+    } else {
+        appendResponse(connection.output, 404, "Not Found", "", "{\"error\":\"not found\"}", sendBody, keepAlive);
+        return;
+    }
+
+    if (ifNoneMatch == etag) {
+        appendResponse(connection.output, 304, "Not Modified", etag, "", false, keepAlive);
+        return;
+    }
+    auto cached = cache.find(cacheKey);
+    if (cached == cache.end()) {
+        if (cache.size() >= maxCachedResponses) cache.clear();
+        std::string body = path == "/today" ? todayJson(today) : sessionsJson(fromDay, toDay);
+        cached = cache.emplace(cacheKey, std::move(body)).first;
+    }
+    appendResponse(connection.output, 200, "OK", etag, cached->second, sendBody, keepAlive);
+}
+
+void HttpServer::handleRequests(Connection& connection) {
+    while (!connection.closeAfterWrite) {
+        size_t headerEnd = connection.input.find("\r\n\r\n");
+        if (headerEnd == std::string::npos) {
+            if (connection.input.size() > maxHeaderBytes) {
+                connection.closeAfterWrite = true;
+                appendResponse(connection.output, 431, "Request Header Fields Too Large", "", "{}", true, false);
+            }
+            return;
+        }
+
+        const char* data = connection.input.data();
+        size_t lineEnd = connection.input.find("\r\n");
+        std::string requestLine(data, lineEnd);
+        size_t firstSpace = requestLine.find(' ');
+        size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+        if (firstSpace == std::string::npos || secondSpace == std::string::npos) {
+            connection.closeAfterWrite = true;
+            appendResponse(connection.output, 400, "Bad Request", "", "{\"error\":\"bad request\"}", true, false);
+            return;
+        }
+        std::string method = requestLine.substr(0, firstSpace);
+        std::string target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+        bool keepAlive = requestLine.compare(secondSpace + 1, std::string::npos, "HTTP/1.1") == 0;
+
+        std::string ifNoneMatch;
+        size_t contentLength = 0;
+        bool validLength = true;
+        bool chunked = false;
+        size_t pos = lineEnd + 2;
+        while (pos < headerEnd) {
+            size_t end = connection.input.find("\r\n", pos);
+            size_t colon = connection.input.find(':', pos);
+            if (colon != std::string::npos && colon < end) {
+                size_t valueStart = connection.input.find_first_not_of(" \t", colon + 1);
+                std::string value = valueStart < end ? connection.input.substr(valueStart, end - valueStart) : "";
+                if (equalsIgnoreCase(data + pos, colon - pos, "if-none-match")) {
+                    ifNoneMatch = value;
+                } else if (equalsIgnoreCase(data + pos, colon - pos, "connection")) {
+                    if (equalsIgnoreCase(value.data(), value.size(), "close")) keepAlive = false;
+                    if (equalsIgnoreCase(value.data(), value.size(), "keep-alive")) keepAlive = true;
+                } else if (equalsIgnoreCase(data + pos, colon - pos, "content-length")) {
+                    validLength = validLength && parseOptionValue(value, contentLength);
+                } else if (equalsIgnoreCase(data + pos, colon - pos, "transfer-encoding")) {
+                    chunked = true;
+                }
+            }
+            pos = end + 2;
+        }
+
+        if (!validLength) {
+            connection.closeAfterWrite = true;
+            appendResponse(connection.output, 400, "Bad Request", "", "{\"error\":\"bad content-length\"}", true, false);
+            return;
+        }
+        // No endpoint reads a request body, but it has to be skipped to find the next request.
+        // Small bodies are waited for and dropped; chunked or large ones end the connection.
+        size_t requestEnd = headerEnd + 4;
+        if (chunked || contentLength > maxBodyBytes) {
+            keepAlive = false;
+            connection.input.clear();
+        } else if (connection.input.size() - requestEnd < contentLength) {
+            return;
+        } else {
+            requestEnd += contentLength;
+        }
+
+        connection.input.erase(0, requestEnd);
+        connection.closeAfterWrite = !keepAlive;
+        respond(connection, method, target, ifNoneMatch);
+    }
+}
+
+#ifdef __linux__
+
+bool HttpServer::start(uint16_t requestedPort) {
+    if (thread.joinable()) return true;
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error: Could not create HTTP socket" << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(requestedPort);
+    socklen_t addressLength = sizeof(address);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0 ||
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+        std::cerr << "Error: Could not listen on 127.0.0.1:" << requestedPort << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    port = ntohs(address.sin_port);
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    stopping = false;
+    thread = std::thread(&HttpServer::run, this);
+    return true;
+}
+
+void HttpServer::stop() {
+    if (thread.joinable()) {
+        stopping = true;
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            std::cerr << "Error: Could not wake the HTTP thread" << std::endl;
+        }
+        thread.join();
+    }
+    for (int* fd : { &listenFd, &epollFd, &wakeFd }) {
+        if (*fd >= 0) close(*fd);
+        *fd = -1;
+    }
+}
+
+void HttpServer::run() {
+    refreshLog();
+    epoll_event events[64];
+    while (!stopping) {
+        int count = epoll_wait(epollFd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        // One stat() per wake-up, shared by every request in the batch
+        refreshLog();
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                uint64_t value;
+                while (read(wakeFd, &value, sizeof(value)) > 0) {}
+                continue;
+            }
+            if (fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) readConnection(fd);
+            if ((events[i].events & EPOLLOUT) && connections.count(fd)) writeConnection(fd);
+        }
+    }
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->first);
+    }
+}
+
+void HttpServer::refreshLog() {
+    // Right after a rotation there is no log.txt until the next write
+    struct stat info;
+    bool exists = stat(logFilePath.c_str(), &info) == 0;
+    uint64_t size = exists ? static_cast<uint64_t>(info.st_size) : 0;
+    uint64_t inode = exists ? static_cast<uint64_t>(info.st_ino) : 0;
+    if (inode == logInode && size == logOffset) return;
+    if (inode != logInode || size < logOffset) {
+        // Log was rotated or replaced; start over
+        blocks.clear();
+        logInode = inode;
+        logOffset = 0;
+        sealedRecords = 0;
+    }
+    uint32_t maxTag = 0;
+    if (logOffset == 0) {
+        // History sealed by log rotation comes first
+        forEachSealedRecord(logFilePath, [&](const LogRecord& record) {
+            sealedRecords++;
+            if (!isBlockEvent(record.event)) return;
+            blocks.push_back(Block{ record.timestamp, record.value, record.tagId, record.event, record.rating });
+            maxTag = std::max(maxTag, record.tagId);
+        });
+    }
+
+    std::FILE* file = exists ? std::fopen(logFilePath.c_str(), "rb") : nullptr;
+    if (file && !seekFile(file, logOffset)) {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    std::vector<char> buffer(1 << 20);
+    std::string carry;
+    LogRecord record;
+    size_t bytesRead;
+    while (file && (bytesRead = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        const char* begin = buffer.data();
+        const char* end = begin + bytesRead;
+        while (begin < end) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!newline) {
+                carry.append(begin, end);
+                break;
+            }
+            bool parsed;
+            if (!carry.empty()) {
+                carry.append(begin, newline);
+                parsed = parseLogLine(carry.data(), carry.size(), record);
+                logOffset += carry.size() + 1;
+                carry.clear();
+            } else {
+                parsed = parseLogLine(begin, newline - begin, record);
+                logOffset += static_cast<uint64_t>(newline - begin) + 1;
+            }
+            if (parsed && isBlockEvent(record.event)) {
+                blocks.push_back(Block{ record.timestamp, record.value, record.tagId, record.event, record.rating });
+                maxTag = std::max(maxTag, record.tagId);
+            }
+            begin = newline + 1;
+        }
+    }
+    // A partial last line stays unread until its newline arrives
+    if (file) std::fclose(file);
+
+    cache.clear();
+    if (!tags || maxTag >= tags->size()) {
+        tags.reset(new TagTable());
+    }
+}
+
+void HttpServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        connections[fd];
+    }
+}
+
+void HttpServer::readConnection(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    Connection& connection = it->second;
+    char buffer[16384];
+    while (true) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            connection.input.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            closeConnection(fd);
+            return;
+        }
+        break;
+    }
+    handleRequests(connection);
+    writeConnection(fd);
+}
+
+void HttpServer::writeConnection(int fd) {
+    Connection& connection = connections[fd];
+    while (connection.written < connection.output.size()) {
+        ssize_t n = send(fd, connection.output.data() + connection.written,
+                         connection.output.size() - connection.written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                closeConnection(fd);
+                return;
+            }
+            if (!connection.waitingForWrite) {
+                epoll_event event;
+                std::memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+                event.data.fd = fd;
+                epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+                connection.waitingForWrite = true;
+            }
+            return;
+        }
+        connection.written += static_cast<size_t>(n);
+    }
+    connection.output.clear();
+    connection.written = 0;
+    if (connection.closeAfterWrite) {
+        closeConnection(fd);
+        return;
+    }
+    if (connection.waitingForWrite) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        connection.waitingForWrite = false;
+    }
+}
+
+void HttpServer::closeConnection(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
+
+#else
+
+bool HttpServer::start(uint16_t) {
+    std::cerr << "Error: The HTTP API needs Linux (epoll)" << std::endl;
+    return false;
+}
+
+void HttpServer::stop() {}
+void HttpServer::run() {}
+void HttpServer::refreshLog() {}
+void HttpServer::acceptConnections() {}
+void HttpServer::readConnection(int) {}
+void HttpServer::writeConnection(int) {}
+void HttpServer::closeConnection(int) {}
+
+#endif
+
+namespace {
+
+std::atomic<bool> interrupted(false);
+
+void onInterrupt(int) {
+    interrupted = true;
+}
+
+#ifdef __linux__
+
+// Blocking keep-alive client used by the load test
+class BenchClient {
+public:
+    explicit BenchClient(uint16_t port) : fd(socket(AF_INET, SOCK_STREAM, 0)) {
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        int noDelay = 1;
+        if (fd >= 0) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    ~BenchClient() {
+        if (fd >= 0) close(fd);
+    }
+
+    bool isOpen() const { return fd >= 0; }
+
+    // Returns the status code, or 0 on a broken connection
+    int get(const std::string& target, const std::string& ifNoneMatch, std::string& etag, size_t& bodyBytes) {
+        std::string request = "GET " + target + " HTTP/1.1\r\nHost: 127.0.0.1\r\n";
+        if (!ifNoneMatch.empty()) request += "If-None-Match: " + ifNoneMatch + "\r\n";
+        request += "\r\n";
+        if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) return 0;
+
+        size_t headerEnd;
+        while ((headerEnd = input.find("\r\n\r\n")) == std::string::npos) {
+            if (!receive()) return 0;
+        }
+        int status = std::atoi(input.c_str() + 9);
+        size_t contentLength = 0;
+        size_t pos = input.find("Content-Length: ");
+        if (pos != std::string::npos && pos < headerEnd) contentLength = std::strtoul(input.c_str() + pos + 16, nullptr, 10);
+        pos = input.find("ETag: ");
+        if (pos != std::string::npos && pos < headerEnd) etag = input.substr(pos + 6, input.find("\r\n", pos) - pos - 6);
+        while (input.size() < headerEnd + 4 + contentLength) {
+            if (!receive()) return 0;
+        }
+        bodyBytes = contentLength;
+        input.erase(0, headerEnd + 4 + contentLength);
+        return status;
+    }
+
+private:
+    int fd;
+    std::string input;
+
+    bool receive() {
+        char buffer[65536];
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return false;
+        input.append(buffer, static_cast<size_t>(n));
+        return true;
+    }
+};
+
+int runServeBench(int connections, double seconds) {
+    StatusBoard board;
+    HttpServer server(board);
+    if (!server.start(0)) return 1;
+
+    std::string today = formatEpoch(localNow()).substr(0, 10);
+    std::string monthAgo = formatEpoch(localNow() - 30 * 86400).substr(0, 10);
+    const std::vector<std::string> targets = { "/status", "/today", "/sessions?from=" + monthAgo + "&to=" + today };
+
+    // Stand-in for the timer loop: publishes every 100 ms and records how long publishing takes
+    std::atomic<bool> done(false);
+    double slowestPublishUs = 0;
+    std::thread timerLoop([&]() {
+        TimerStatus status;
+        status.available = true;
+        status.running = true;
+        status.focusMinutes = 25;
+        status.restMinutes = 5;
+        std::snprintf(status.tag, sizeof(status.tag), "bench");
+        while (!done) {
+            status.elapsedSeconds++;
+            status.remainingSeconds = 25 * 60 - status.elapsedSeconds % (25 * 60);
+            auto start = std::chrono::steady_clock::now();
+            board.publish(status);
+            slowestPublishUs = std::max(slowestPublishUs,
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    });
+
+    struct Result {
+        std::vector<double> micros;
+        uint64_t ok = 0;
+        uint64_t notModified = 0;
+        uint64_t errors = 0;
+        uint64_t bytes = 0;
+    };
+    std::vector<Result> results(static_cast<size_t>(connections));
+    std::vector<std::thread> clients;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                           std::chrono::duration<double>(seconds));
+    for (int c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c]() {
+            Result& result = results[static_cast<size_t>(c)];
+            BenchClient client(server.getPort());
+            if (!client.isOpen()) {
+                result.errors++;
+                return;
+            }
+            std::vector<std::string> etags(targets.size());
+            size_t bodyBytes = 0;
+            // Warm-up: the server loads the log before answering its first request
+            client.get(targets[0], "", etags[0], bodyBytes);
+            for (uint64_t i = 0; std::chrono::steady_clock::now() < deadline; ++i) {
+                size_t t = i % targets.size();
+                // Every other round is a conditional poll, like a dashboard would send
+                std::string condition = (i / targets.size()) % 2 ? etags[t] : std::string();
+                auto start = std::chrono::steady_clock::now();
+                int status = client.get(targets[t], condition, etags[t], bodyBytes);
+                result.micros.push_back(
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+                if (status == 200) {
+                    result.ok++;
+                    result.bytes += bodyBytes;
+                } else if (status == 304) {
+                    result.notModified++;
+                } else {
+                    result.errors++;
+                    if (status == 0) return;
+                }
+            }
+        });
+    }
+    for (std::thread& client : clients) client.join();
+    done = true;
+    timerLoop.join();
+    server.stop();
+
+    Result total;
+    for (Result& result : results) {
+        total.micros.insert(total.micros.end(), result.micros.begin(), result.micros.end());
+        total.ok += result.ok;
+        total.notModified += result.notModified;
+        total.errors += result.errors;
+        total.bytes += result.bytes;
+    }
+    std::sort(total.micros.begin(), total.micros.end());
+    size_t n = total.micros.size();
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << connections << " keep-alive connections, " << seconds << " s\n";
+    std::cout << n << " requests (" << total.ok << " 200, " << total.notModified << " 304, " << total.errors
+              << " errors), " << n / seconds << " req/s, " << total.bytes / seconds / 1e6 << " MB/s of bodies\n";
+    if (n > 0) {
+        std::cout << "latency us: p50 " << total.micros[n / 2] << ", p99 " << total.micros[n * 99 / 100]
+                  << ", max " << total.micros[n - 1] << "\n";
+    }
+    std::cout << "slowest StatusBoard::publish in the timer loop: " << slowestPublishUs << " us" << std::endl;
+    return total.errors > 0 ? 2 : 0;
+}
+
+#endif
+
+} // namespace
+
+int runServeCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI serve [port=8765]\n"
+        "       ADHDPomodoro-CLI serve bench [connections=8] [seconds=5]";
+    bool bench = false;
+    int port = 8765;
+    int connections = 8;
+    double seconds = 5;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (arg == "bench") {
+            bench = true;
+        } else if (key == "port" && parseOptionValue(value, port) && port > 0 && port < 65536) {
+        } else if (key == "connections" && parseOptionValue(value, connections)) {
+            connections = std::max(1, connections);
+        } else if (key == "seconds" && parseOptionValue(value, seconds)) {
+            seconds = std::max(0.1, seconds);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+#ifdef __linux__
+    if (bench) {
+        return runServeBench(connections, seconds);
+    }
+#else
+    (void)bench;
+    (void)connections;
+    (void)seconds;
+#endif
+
+    // History only; /status reports "available": false without a running timer
+    StatusBoard board;
+    HttpServer server(board);
+    if (!server.start(static_cast<uint16_t>(port))) return 1;
+    std::signal(SIGINT, onInterrupt);
+    std::cout << "Serving http://127.0.0.1:" << server.getPort() << " (Ctrl+C to stop)" << std::endl;
+    while (!interrupted) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    return 0;
+}
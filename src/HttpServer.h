@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "PomodoroManager.h"
+#include "SessionLog.h"
+#include "TagTable.h"
+
+// Snapshot of the running timer as shown by /status
+struct TimerStatus {
+    bool available = false;         // false until a timer publishes
+    State state = State::Focus;
+    bool running = false;
+    bool paused = false;
+    int elapsedSeconds = 0;
+    int remainingSeconds = 0;
+    int totalFocusSeconds = 0;
+    int focusMinutes = 0;
+    int restMinutes = 0;
+    char tag[64] = {};
+};
+
+/**
+ * Hands timer snapshots from the timer loop to the HTTP thread.
+ * publish() only ever try-locks, so a slow reader can never delay the timer;
+ * a skipped snapshot is replaced by the next one a frame later.
+ */
+class StatusBoard {
+public:
+    void publish(const TimerStatus& status);
+    // Copies the latest snapshot; the returned version changes whenever it does
+    uint64_t read(TimerStatus& out);
+
+private:
+    std::mutex mutex;
+    TimerStatus current;
+    uint64_t version = 0;
+};
+
+/**
+ * Local HTTP/1.1 JSON API on 127.0.0.1 (epoll, keep-alive, one thread).
+ *
+ *   GET /status                          timer state from the StatusBoard
+ *   GET /today                           today's focus/rest totals and ratings
+ *   GET /sessions?from=YYYY-MM-DD&to=..  Focus/Hyperfocus/Rest/Idle blocks
+ *
+ * The server tails log.txt read-only on its own thread, keeping compact
+ * duration records in memory; a rotation is noticed by the inode of log.txt
+ * changing and the sealed history is read again. History responses are
+ * cached until the log grows and carry the count of sealed records and the
+ * offset read in log.txt as ETag, so polls with
+ * If-None-Match are answered with 304 without touching the log.
+ * Only available on Linux; start() fails elsewhere.
+ */
+class HttpServer {
+public:
+    explicit HttpServer(StatusBoard& board, const std::string& logPath = "log.txt");
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    // Bind 127.0.0.1:port (0 = any free port) and start the server thread
+    bool start(uint16_t port);
+    void stop();
+    uint16_t getPort() const { return port; }
+
+private:
+    struct Connection {
+        std::string input;
+        std::string output;
+        size_t written = 0;
+        bool closeAfterWrite = false;
+        bool waitingForWrite = false;
+    };
+
+    // A logged duration block
+    struct Block {
+        int64_t end;
+        uint32_t minutes;
+        uint32_t tagId;
+        LogEvent event;
+        Rating rating;
+    };
+
+    StatusBoard& board;
+    std::string logFilePath;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    uint16_t port;
+    std::thread thread;
+    std::atomic<bool> stopping;
+
+    // Everything below is owned by the server thread
+    std::unordered_map<int, Connection> connections;
+    uint64_t logInode;
+    uint64_t logOffset;                                   // bytes read from the live log
+    uint64_t sealedRecords;                               // records read from sealed segments
+    std::vector<Block> blocks;
+    std::unique_ptr<TagTable> tags;
+    std::unordered_map<std::string, std::string> cache;   // route and day range -> body for the current logOffset
+    uint64_t statusVersion;
+    std::string statusBody;
+
+    void run();
+    void refreshLog();
+    void acceptConnections();
+    void readConnection(int fd);
+    void writeConnection(int fd);
+    void closeConnection(int fd);
+    void handleRequests(Connection& connection);
+    void respond(Connection& connection, const std::string& method, const std::string& target,
+                 const std::string& ifNoneMatch);
+
+    std::string statusJson(const TimerStatus& status) const;
+    std::string todayJson(int32_t day);
+    std::string sessionsJson(int32_t fromDay, int32_t toDay);
+};
+
+// "ADHDPomodoro-CLI serve [port=8765] | serve bench [connections=8] [seconds=5]"
+int runServeCommand(int argc, char* argv[]);
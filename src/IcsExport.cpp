@@ -0,0 +1,289 @@
+#include "IcsExport.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include "LogArchive.h"
+#include "SessionLog.h"
+#include "TagTable.h"
+
+namespace {
+
+// Fixed-size output buffer that writes RFC 5545 content lines (CRLF, folded at 75 octets)
+class IcsWriter {
+public:
+    explicit IcsWriter(std::FILE* file) : file(file), used(0), lineOctets(0), total(0) {}
+
+    void raw(const char* data, size_t length) {
+        while (length > 0) {
+            size_t chunk = std::min(length, sizeof(buffer) - used);
+            std::memcpy(buffer + used, data, chunk);
+            used += chunk;
+            data += chunk;
+            length -= chunk;
+            if (used == sizeof(buffer)) flush();
+        }
+    }
+
+    void beginLine(const char* name) {
+        lineOctets = 0;
+        for (const char* p = name; *p; ++p) lineChar(*p);
+        lineChar(':');
+    }
+
+    void endLine() { raw("\r\n", 2); }
+
+    // Property with a fixed value
+    void line(const char* name, const char* value) {
+        beginLine(name);
+        for (const char* p = value; *p; ++p) lineChar(*p);
+        endLine();
+    }
+
+    // TEXT value with backslash, comma, semicolon and newline escaped
+    void text(const char* value, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            char c = value[i];
+            if (c == '\\' || c == ',' || c == ';') {
+                lineChar('\\');
+                lineChar(c);
+            } else if (c == '\n') {
+                lineChar('\\');
+                lineChar('n');
+            } else if (c != '\r') {
+                lineChar(c);
+            }
+        }
+    }
+    void text(const char* value) { text(value, std::strlen(value)); }
+    void text(const std::string& value) { text(value.data(), value.size()); }
+
+    void number(uint64_t value) {
+        char digits[20];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (count > 0) lineChar(digits[--count]);
+    }
+
+    // DATE-TIME form "YYYYMMDDTHHMMSS"
+    void dateTime(int64_t epoch) {
+        int year, month, day, hour, minute, second;
+        epochToCivil(epoch, year, month, day, hour, minute, second);
+        char text[16];
+        writeDigits(text, year, 4);
+        writeDigits(text + 4, month, 2);
+        writeDigits(text + 6, day, 2);
+        text[8] = 'T';
+        writeDigits(text + 9, hour, 2);
+        writeDigits(text + 11, minute, 2);
+        writeDigits(text + 13, second, 2);
+        for (int i = 0; i < 15; ++i) lineChar(text[i]);
+    }
+
+    void flush() {
+        if (used > 0) std::fwrite(buffer, 1, used, file);
+        total += used;
+        used = 0;
+    }
+
+    uint64_t bytesWritten() const { return total + used; }
+
+private:
+    std::FILE* file;
+    char buffer[1 << 16];
+    size_t used;
+    size_t lineOctets;
+    uint64_t total;
+
+    void lineChar(char c) {
+        // Fold before a character that would take the line past 75 octets; a UTF-8
+        // lead byte counts its whole sequence, so sequences are never split
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if ((byte & 0xC0) != 0x80 && lineOctets + sequenceLength(byte) > 75) {
+            raw("\r\n ", 3);
+            lineOctets = 1;
+        }
+        buffer[used++] = c;
+        lineOctets++;
+        if (used == sizeof(buffer)) flush();
+    }
+
+    static size_t sequenceLength(unsigned char lead) {
+        if (lead >= 0xF0) return 4;
+        if (lead >= 0xE0) return 3;
+        if (lead >= 0xC0) return 2;
+        return 1;
+    }
+
+    static void writeDigits(char* out, int value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+};
+
+const char* blockName(LogEvent event) {
+    switch (event) {
+        case LogEvent::Focus: return "Focus";
+        case LogEvent::Hyperfocus: return "Hyperfocus";
+        case LogEvent::Rest: return "Rest";
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+bool exportIcs(const std::string& logPath, const std::string& outputPath, int32_t fromDay, int32_t toDay,
+               IcsExportStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+
+    // Written under a temporary name, so a failed export leaves an existing calendar alone
+    const bool toStdout = outputPath == "-";
+    const std::string temporary = outputPath + ".tmp";
+    std::FILE* file = toStdout ? stdout : std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not create " << temporary << std::endl;
+        return false;
+    }
+    TagTable tags;
+    IcsWriter writer(file);
+
+    writer.line("BEGIN", "VCALENDAR");
+    writer.line("VERSION", "2.0");
+    writer.line("PRODID", "-//ADHDPomodoro//Session History//EN");
+    writer.line("CALSCALE", "GREGORIAN");
+    writer.line("X-WR-CALNAME", "ADHD Pomodoro sessions");
+
+    const int64_t exportTime = static_cast<int64_t>(std::time(nullptr));
+    // Archived segments outside the range are skipped without decoding
+    const int64_t from = fromDay == INT32_MIN ? INT64_MIN : static_cast<int64_t>(fromDay) * 86400;
+    const int64_t to = toDay == INT32_MAX ? INT64_MAX : (static_cast<int64_t>(toDay) + 1) * 86400;
+
+    bool found = forEachHistoryRecord(logPath, from, to, [&](const LogRecord& record, uint64_t ordinal) {
+        uint64_t recordNumber = ordinal + 1;
+        stats.records++;
+        const char* name = blockName(record.event);
+        if (!name) return;
+
+        int64_t begin = record.timestamp - static_cast<int64_t>(record.value) * 60;
+        const std::string& tag = tags.name(record.tagId);
+        const char* rating = ratingName(record.rating);
+
+        writer.line("BEGIN", "VEVENT");
+        // Record position in the log keeps the UID stable across exports
+        writer.beginLine("UID");
+        writer.dateTime(record.timestamp);
+        writer.text("-");
+        writer.number(recordNumber);
+        writer.text("@adhdpomodoro");
+        writer.endLine();
+        writer.beginLine("DTSTAMP");
+        writer.dateTime(exportTime);
+        writer.text("Z");
+        writer.endLine();
+        writer.beginLine("DTSTART");
+        writer.dateTime(begin);
+        writer.endLine();
+        writer.beginLine("DTEND");
+        writer.dateTime(record.timestamp);
+        writer.endLine();
+
+        writer.beginLine("SUMMARY");
+        writer.text(name);
+        if (*rating) {
+            writer.text(" (");
+            writer.text(rating);
+            writer.text(")");
+        }
+        if (!tag.empty()) {
+            writer.text(" - ");
+            writer.text(tag);
+        }
+        writer.endLine();
+
+        writer.beginLine("DESCRIPTION");
+        writer.text(name);
+        writer.text(": ");
+        writer.number(record.value);
+        writer.text(" min");
+        if (*rating) {
+            writer.text(", rated ");
+            writer.text(rating);
+        }
+        if (!tag.empty()) {
+            writer.text(", tag ");
+            writer.text(tag);
+        }
+        writer.endLine();
+
+        writer.beginLine("CATEGORIES");
+        writer.text(name);
+        writer.endLine();
+        writer.line("TRANSP", "TRANSPARENT");
+        writer.line("END", "VEVENT");
+        stats.events++;
+    });
+
+    writer.line("END", "VCALENDAR");
+    writer.flush();
+    stats.bytes = writer.bytesWritten();
+    if (toStdout) {
+        std::fflush(stdout);
+    } else {
+        bool written = std::ferror(file) == 0;
+        written = std::fclose(file) == 0 && written;
+        std::error_code error;
+        if (found && written) std::filesystem::rename(temporary, outputPath, error);
+        if (!found || !written || error) {
+            std::filesystem::remove(temporary, error);
+            if (found) {
+                std::cerr << "Error: Could not write " << outputPath << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if (!found) {
+        std::cerr << "Error: Could not open " << logPath << std::endl;
+        return false;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+int runExportIcsCommand(int argc, char* argv[]) {
+    const char* usage = "Usage: ADHDPomodoro-CLI export-ics [--from YYYY-MM-DD] [--to YYYY-MM-DD] [-o sessions.ics]";
+    int32_t fromDay = INT32_MIN;
+    int32_t toDay = INT32_MAX;
+    std::string output = "-";
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        int64_t epoch;
+        if ((arg == "--from" || arg == "--to") && i + 1 < argc &&
+            parseEpoch(argv[i + 1], std::strlen(argv[i + 1]), epoch)) {
+            (arg == "--from" ? fromDay : toDay) = epochDay(epoch);
+            ++i;
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    IcsExportStats stats;
+    if (!exportIcs("log.txt", output, fromDay, toDay, stats)) {
+        return 1;
+    }
+    // Keep stdout clean when the calendar itself goes there
+    std::ostream& report = output == "-" ? std::cerr : std::cout;
+    report << "Exported " << stats.events << " events from " << stats.records << " records ("
+           << stats.bytes << " bytes) in " << stats.seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * iCalendar (RFC 5545) export of the session log.
+ *
+ * Every Focus, Hyperfocus and Rest record becomes one VEVENT ending at the
+ * time the record was logged and starting its logged minutes earlier.
+ * Times are written as floating local time, the same way log.txt stores
+ * them. The log is streamed once and events are formatted into a fixed
+ * output buffer, so memory use does not depend on the history length.
+ */
+
+struct IcsExportStats {
+    uint64_t records = 0;
+    uint64_t events = 0;
+    uint64_t bytes = 0;
+    double seconds = 0;
+};
+
+// Export records whose day lies in [fromDay, toDay] (days since 1970-01-01) to outputPath ("-" = stdout)
+bool exportIcs(const std::string& logPath, const std::string& outputPath, int32_t fromDay, int32_t toDay,
+               IcsExportStats& stats);
+
+// "ADHDPomodoro-CLI export-ics [--from YYYY-MM-DD] [--to YYYY-MM-DD] [-o FILE]"
+int runExportIcsCommand(int argc, char* argv[]);
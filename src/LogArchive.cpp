@@ -0,0 +1,686 @@
+#include "LogArchive.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+const char archiveMagic[4] = { 'P', 'L', 'A', 'R' };
+const uint32_t archiveVersion = 1;
+const char* const archiveExtension = ".pla";
+const int columnCount = 5;
+const size_t footerSize = 2 * sizeof(int64_t) + sizeof(uint64_t) + sizeof(archiveMagic);
+
+void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(const uint8_t*& pos, const uint8_t* end, uint64_t& out) {
+    out = 0;
+    for (int shift = 0; pos < end && shift < 64; shift += 7) {
+        uint8_t byte = *pos++;
+        out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+template <typename T>
+void appendRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T readRaw(const uint8_t* pos) {
+    T value;
+    std::memcpy(&value, pos, sizeof(value));
+    return value;
+}
+
+// "dir/log.txt" -> ("dir", "log", ".txt")
+void splitLogPath(const std::string& logPath, std::filesystem::path& dir, std::string& stem, std::string& extension) {
+    std::filesystem::path path(logPath);
+    dir = path.parent_path();
+    if (dir.empty()) dir = ".";
+    stem = path.stem().string();
+    extension = path.extension().string();
+}
+
+// Decode a whole archive held in memory
+bool decodeArchive(const std::vector<uint8_t>& data, const std::function<void(const LogRecord&)>& callback) {
+    const size_t headerSize = sizeof(archiveMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+    if (data.size() < headerSize + footerSize || std::memcmp(data.data(), archiveMagic, sizeof(archiveMagic)) != 0 ||
+        readRaw<uint32_t>(data.data() + 4) != archiveVersion ||
+        std::memcmp(data.data() + data.size() - sizeof(archiveMagic), archiveMagic, sizeof(archiveMagic)) != 0) {
+        return false;
+    }
+    const uint64_t count = readRaw<uint64_t>(data.data() + 8);
+    const uint8_t* pos = data.data() + headerSize;
+    const uint8_t* end = data.data() + data.size() - footerSize;
+
+    const uint8_t* columns[columnCount];
+    const uint8_t* columnEnds[columnCount];
+    for (int c = 0; c < columnCount; ++c) {
+        if (end - pos < 4) return false;
+        uint32_t length = readRaw<uint32_t>(pos);
+        pos += 4;
+        if (static_cast<uint64_t>(end - pos) < length) return false;
+        columns[c] = pos;
+        columnEnds[c] = pos + length;
+        pos += length;
+    }
+    if (static_cast<uint64_t>(columnEnds[1] - columns[1]) < (count + 1) / 2 ||
+        static_cast<uint64_t>(columnEnds[2] - columns[2]) < (count + 3) / 4) {
+        return false;
+    }
+
+    const uint8_t* times = columns[0];
+    const uint8_t* values = columns[3];
+    const uint8_t* tags = columns[4];
+    LogRecord record;
+    int64_t time = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t delta, value, tag;
+        if (!readVarint(times, columnEnds[0], delta) || !readVarint(values, columnEnds[3], value) ||
+            !readVarint(tags, columnEnds[4], tag)) {
+            return false;
+        }
+        time += unzigzag(delta);
+        uint8_t event = (columns[1][i / 2] >> ((i % 2) * 4)) & 0x0F;
+        uint8_t rating = (columns[2][i / 4] >> ((i % 4) * 2)) & 0x03;
+        if (event >= static_cast<uint8_t>(LogEvent::Count)) return false;
+        record.timestamp = time;
+        record.event = static_cast<LogEvent>(event);
+        record.rating = static_cast<Rating>(rating);
+        record.value = static_cast<uint32_t>(value);
+        record.tagId = static_cast<uint32_t>(tag);
+        callback(record);
+    }
+    return true;
+}
+
+bool readWholeFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    bool ok = data.empty() || std::fread(data.data(), 1, data.size(), file) == data.size();
+    std::fclose(file);
+    return ok;
+}
+
+// Rename that fails rather than replace an existing target (exists tells which)
+bool renameNoReplace(const std::string& from, const std::string& to, bool& exists) {
+    exists = false;
+#ifdef _WIN32
+    if (MoveFileExA(from.c_str(), to.c_str(), 0)) return true;
+    DWORD code = GetLastError();
+    exists = code == ERROR_ALREADY_EXISTS || code == ERROR_FILE_EXISTS;
+    return false;
+#else
+    if (link(from.c_str(), to.c_str()) == 0) {
+        unlink(from.c_str());
+        return true;
+    }
+    exists = errno == EEXIST;
+    if (exists || (errno != EPERM && errno != ENOTSUP)) return false;
+    // File systems without hard links
+    std::error_code error;
+    if (std::filesystem::exists(to, error)) {
+        exists = true;
+        return false;
+    }
+    std::filesystem::rename(from, to, error);
+    return !error;
+#endif
+}
+
+void lowerThreadPriority() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+    // Linux keeps nice values per thread, so this leaves the timer thread alone
+    setpriority(PRIO_PROCESS, 0, 10);
+#endif
+}
+
+} // namespace
+
+std::string segmentPath(const std::string& logPath, uint32_t sequence, bool archived) {
+    std::filesystem::path dir;
+    std::string stem, extension;
+    splitLogPath(logPath, dir, stem, extension);
+    char number[16];
+    std::snprintf(number, sizeof(number), ".%06u", sequence);
+    std::filesystem::path path = std::filesystem::path(logPath).parent_path() /
+                                 (stem + number + (archived ? archiveExtension : extension));
+    return path.string();
+}
+
+std::vector<LogSegment> listSegments(const std::string& logPath) {
+    std::filesystem::path dir;
+    std::string stem, extension;
+    splitLogPath(logPath, dir, stem, extension);
+
+    // An archive replaces its text segment; both exist only while it is being removed
+    std::map<uint32_t, LogSegment> found;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= stem.size() + 1 || name.compare(0, stem.size() + 1, stem + ".") != 0) continue;
+        size_t pos = stem.size() + 1;
+        size_t digitsEnd = pos;
+        while (digitsEnd < name.size() && name[digitsEnd] >= '0' && name[digitsEnd] <= '9') ++digitsEnd;
+        if (digitsEnd == pos || digitsEnd - pos > 9) continue;
+        std::string rest = name.substr(digitsEnd);
+        bool archived = rest == archiveExtension;
+        if (!archived && rest != extension) continue;
+
+        uint32_t sequence = static_cast<uint32_t>(std::stoul(name.substr(pos, digitsEnd - pos)));
+        auto it = found.find(sequence);
+        if (it == found.end() || archived) {
+            found[sequence] = LogSegment{ sequence, segmentPath(logPath, sequence, archived), archived };
+        }
+    }
+
+    std::vector<LogSegment> segments;
+    for (const auto& entry : found) segments.push_back(entry.second);
+    return segments;
+}
+
+namespace {
+
+bool writeArchive(const std::string& textPath, const std::string& archivePath, ArchiveFooter& footer) {
+    std::string columns[columnCount];
+    footer = ArchiveFooter();
+    footer.minTime = INT64_MAX;
+    footer.maxTime = INT64_MIN;
+    int64_t previous = 0;
+    bool found = forEachLogRecord(textPath, [&](const LogRecord& record) {
+        uint64_t i = footer.records++;
+        appendVarint(columns[0], zigzag(record.timestamp - previous));
+        previous = record.timestamp;
+        if (i % 2 == 0) columns[1].push_back(0);
+        columns[1].back() = static_cast<char>(columns[1].back() | (static_cast<uint8_t>(record.event) << ((i % 2) * 4)));
+        if (i % 4 == 0) columns[2].push_back(0);
+        columns[2].back() = static_cast<char>(columns[2].back() | (static_cast<uint8_t>(record.rating) << ((i % 4) * 2)));
+        appendVarint(columns[3], record.value);
+        appendVarint(columns[4], record.tagId);
+        footer.minTime = std::min(footer.minTime, record.timestamp);
+        footer.maxTime = std::max(footer.maxTime, record.timestamp);
+    });
+    if (!found) {
+        std::cerr << "Error: Could not open " << textPath << std::endl;
+        return false;
+    }
+    if (footer.records == 0) {
+        footer.minTime = 0;
+        footer.maxTime = 0;
+    }
+
+    std::string data;
+    data.append(archiveMagic, sizeof(archiveMagic));
+    appendRaw(data, archiveVersion);
+    appendRaw(data, footer.records);
+    for (const std::string& column : columns) {
+        appendRaw(data, static_cast<uint32_t>(column.size()));
+        data += column;
+    }
+    appendRaw(data, footer.minTime);
+    appendRaw(data, footer.maxTime);
+    appendRaw(data, footer.records);
+    data.append(archiveMagic, sizeof(archiveMagic));
+
+    // Written under a temporary name so readers never see a partial archive
+    std::string temporary = archivePath + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not create " << temporary << std::endl;
+        return false;
+    }
+    bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = std::fclose(file) == 0 && written;
+    std::error_code error;
+    if (written) std::filesystem::rename(temporary, archivePath, error);
+    if (!written || error) {
+        std::cerr << "Error: Could not write " << archivePath << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    std::filesystem::remove(textPath, error);
+    return true;
+}
+
+} // namespace
+
+bool compactSegment(const std::string& textPath, const std::string& archivePath, ArchiveFooter& footer) {
+    std::FILE* segment = std::fopen(textPath.c_str(), "rb");
+    if (!segment) {
+        std::cerr << "Error: Could not open " << textPath << std::endl;
+        return false;
+    }
+    // Another process compacting the same segment holds the lock until it has removed the text
+    lockFile(segment);
+    bool compacted = isSameFile(segment, textPath) && writeArchive(textPath, archivePath, footer);
+    unlockFile(segment);
+    std::fclose(segment);
+    return compacted;
+}
+
+bool readArchiveFooter(const std::string& archivePath, ArchiveFooter& footer) {
+    std::FILE* file = std::fopen(archivePath.c_str(), "rb");
+    if (!file) return false;
+    uint8_t data[footerSize];
+    bool ok = std::fseek(file, -static_cast<long>(footerSize), SEEK_END) == 0 &&
+              std::fread(data, 1, footerSize, file) == footerSize &&
+              std::memcmp(data + footerSize - sizeof(archiveMagic), archiveMagic, sizeof(archiveMagic)) == 0;
+    std::fclose(file);
+    if (!ok) return false;
+    footer.minTime = readRaw<int64_t>(data);
+    footer.maxTime = readRaw<int64_t>(data + 8);
+    footer.records = readRaw<uint64_t>(data + 16);
+    return true;
+}
+
+bool forEachArchiveRecord(const std::string& archivePath, const std::function<void(const LogRecord&)>& callback) {
+    std::vector<uint8_t> data;
+    if (!readWholeFile(archivePath, data)) return false;
+    if (!decodeArchive(data, callback)) {
+        std::cerr << "Error: " << archivePath << " is not a valid log archive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool forEachSegmentRecord(const std::string& logPath, const LogSegment& segment,
+                          const std::function<void(const LogRecord&)>& callback) {
+    if (!segment.archived && forEachLogRecord(segment.path, callback)) return true;
+    // A text segment may have been compacted since it was listed
+    return forEachArchiveRecord(segment.archived ? segment.path : segmentPath(logPath, segment.sequence, true),
+                                callback);
+}
+
+namespace {
+
+// Records of the sealed segments in [from, to); returns whether any segment exists
+bool forEachSealedRange(const std::string& logPath, int64_t from, int64_t to, uint64_t& ordinal,
+                        const std::function<void(const LogRecord&, uint64_t)>& callback) {
+    auto visit = [&](const LogRecord& record) {
+        if (record.timestamp >= from && record.timestamp < to) callback(record, ordinal);
+        ordinal++;
+    };
+    std::vector<LogSegment> segments = listSegments(logPath);
+    for (const LogSegment& segment : segments) {
+        if (!segment.archived && forEachLogRecord(segment.path, visit)) continue;
+        std::string archive = segment.archived ? segment.path : segmentPath(logPath, segment.sequence, true);
+        ArchiveFooter footer;
+        if (!readArchiveFooter(archive, footer)) {
+            std::cerr << "Error: Could not read " << archive << std::endl;
+            continue;
+        }
+        if (footer.records == 0 || footer.maxTime < from || footer.minTime >= to) {
+            ordinal += footer.records;
+            continue;
+        }
+        forEachArchiveRecord(archive, visit);
+    }
+    return !segments.empty();
+}
+
+} // namespace
+
+bool forEachHistoryRecord(const std::string& logPath, int64_t from, int64_t to,
+                          const std::function<void(const LogRecord& record, uint64_t ordinal)>& callback) {
+    uint64_t ordinal = 0;
+    bool sealed = forEachSealedRange(logPath, from, to, ordinal, callback);
+    bool live = forEachLogRecord(logPath, [&](const LogRecord& record) {
+        if (record.timestamp >= from && record.timestamp < to) callback(record, ordinal);
+        ordinal++;
+    });
+    return sealed || live;
+}
+
+bool forEachHistoryRecord(const std::string& logPath, const std::function<void(const LogRecord&)>& callback) {
+    return forEachHistoryRecord(logPath, INT64_MIN, INT64_MAX,
+                                [&callback](const LogRecord& record, uint64_t) { callback(record); });
+}
+
+void forEachSealedRecord(const std::string& logPath, const std::function<void(const LogRecord&)>& callback) {
+    uint64_t ordinal = 0;
+    forEachSealedRange(logPath, INT64_MIN, INT64_MAX, ordinal,
+                       [&callback](const LogRecord& record, uint64_t) { callback(record); });
+}
+
+LogArchiver::LogArchiver(const std::string& configPath)
+    : maxBytes(0), monthly(false), logFilePath("log.txt"), pending(false), stopping(false) {
+    std::ifstream config(configPath);
+    uint64_t megabytes = 0;
+    int monthlyFlag = 0;
+    if (config >> megabytes >> monthlyFlag) {
+        maxBytes = megabytes * 1024 * 1024;
+        monthly = monthlyFlag != 0;
+    }
+}
+
+LogArchiver::~LogArchiver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+void LogArchiver::attach(SessionLogger& logger) {
+    logFilePath = logger.getPath();
+    if (logFilePath.empty()) return;
+    if (isEnabled()) {
+        logger.setRotation(maxBytes, monthly, [this](const std::string& path) {
+            bool sealed = seal(path);
+            if (sealed) schedule();
+            return sealed;
+        });
+    }
+    for (const LogSegment& segment : listSegments(logFilePath)) {
+        if (!segment.archived) {
+            schedule();
+            break;
+        }
+    }
+}
+
+void LogArchiver::schedule() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    if (!worker.joinable()) worker = std::thread(&LogArchiver::run, this);
+    wake.notify_one();
+}
+
+void LogArchiver::run() {
+    lowerThreadPriority();
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return pending || stopping; });
+        // Segments still pending at exit are compacted on the next start
+        if (stopping) return;
+        pending = false;
+        lock.unlock();
+        compactAll(logFilePath);
+        lock.lock();
+    }
+}
+
+bool LogArchiver::seal(const std::string& logPath) {
+    std::FILE* file = std::fopen(logPath.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Error: Could not seal " << logPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    // Writers append under the same lock and reopen the log once it has been renamed
+    lockFile(file);
+    bool sealed = !isSameFile(file, logPath);     // another process sealed it first
+    std::vector<LogSegment> segments = listSegments(logPath);
+    uint32_t next = segments.empty() ? 1 : segments.back().sequence + 1;
+    // A process sealing its own log at the same moment may take the number first
+    for (int attempt = 0; !sealed && attempt < 100; ++attempt, ++next) {
+        bool exists;
+        sealed = renameNoReplace(logPath, segmentPath(logPath, next, false), exists);
+        if (!sealed && !exists) {
+            std::cerr << "Error: Could not seal " << logPath << std::endl;
+            break;
+        }
+    }
+    unlockFile(file);
+    std::fclose(file);
+    return sealed;
+}
+
+size_t LogArchiver::compactAll(const std::string& logPath) {
+    size_t converted = 0;
+    for (const LogSegment& segment : listSegments(logPath)) {
+        if (segment.archived) continue;
+        ArchiveFooter footer;
+        if (compactSegment(segment.path, segmentPath(logPath, segment.sequence, true), footer)) converted++;
+    }
+    return converted;
+}
+
+namespace {
+
+uint64_t fileSize(const std::string& path) {
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(path, error);
+    return error ? 0 : size;
+}
+
+void printStatus(const std::string& logPath) {
+    LogArchiver archiver;
+    if (archiver.isEnabled()) {
+        std::cout << "Rotation: ";
+        if (archiver.getMaxBytes() > 0) std::cout << archiver.getMaxBytes() / (1024 * 1024) << " MB";
+        if (archiver.getMaxBytes() > 0 && archiver.isMonthly()) std::cout << " or ";
+        if (archiver.isMonthly()) std::cout << "monthly";
+        std::cout << "\n";
+    } else {
+        std::cout << "Rotation: off (enable with \"archive enable\")\n";
+    }
+
+    uint64_t archiveBytes = 0, archiveRecords = 0;
+    for (const LogSegment& segment : listSegments(logPath)) {
+        uint64_t size = fileSize(segment.path);
+        std::cout << std::setw(6) << segment.sequence << "  " << std::left << std::setw(24)
+                  << std::filesystem::path(segment.path).filename().string() << std::right << std::setw(12) << size
+                  << " bytes";
+        ArchiveFooter footer;
+        if (segment.archived && readArchiveFooter(segment.path, footer)) {
+            archiveBytes += size;
+            archiveRecords += footer.records;
+            std::cout << std::setw(10) << footer.records << " records";
+            if (footer.records > 0) {
+                std::cout << "  " << formatEpoch(footer.minTime).substr(0, 10) << " to "
+                          << formatEpoch(footer.maxTime).substr(0, 10);
+            }
+        } else if (!segment.archived) {
+            std::cout << "  (waiting for compaction)";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "Live log " << logPath << ": " << fileSize(logPath) << " bytes\n";
+    if (archiveRecords > 0) {
+        std::cout << "Archived: " << archiveRecords << " records in " << archiveBytes << " bytes ("
+                  << std::fixed << std::setprecision(2) << static_cast<double>(archiveBytes) / archiveRecords
+                  << " bytes/record)\n";
+    }
+}
+
+// Synthetic sessions spread over months, one text segment per month
+int runArchiveBench(uint64_t recordCount) {
+    std::error_code error;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(error) / "pomodoro-archive-bench";
+    std::filesystem::remove_all(dir, error);
+    std::filesystem::create_directories(dir, error);
+    const std::string logPath = (dir / "log.txt").string();
+    const std::string allPath = (dir / "all.txt").string();
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> focusMinutes(10, 60);
+    std::uniform_int_distribution<int> gapMinutes(5, 240);
+    std::uniform_int_distribution<int> rating(1, 3);
+    std::uniform_int_distribution<int> tag(0, 12);
+    std::ofstream all(allPath, std::ios::binary);
+    std::ofstream segment;
+    uint32_t sequence = 0;
+    uint32_t month = 0;
+    int64_t time = civilToEpoch(2020, 1, 1, 8);
+    std::string line;
+    uint64_t written = 0;
+    auto emit = [&](LogEvent event, uint32_t value, Rating r, uint32_t tagId) {
+        LogRecord record{ time, event, r, value, tagId };
+        if (epochMonth(time) != month) {
+            month = epochMonth(time);
+            segment.close();
+            segment.open(segmentPath(logPath, ++sequence, false), std::ios::binary);
+        }
+        line.clear();
+        appendLogLine(record, line);
+        line.push_back('\n');
+        all << line;
+        segment << line;
+        written++;
+    };
+    while (written < recordCount) {
+        uint32_t tagId = static_cast<uint32_t>(tag(rng));
+        emit(LogEvent::SessionStarted, 0, Rating::None, tagId);
+        int minutes = focusMinutes(rng);
+        time += minutes * 60;
+        emit(LogEvent::Focus, static_cast<uint32_t>(minutes), static_cast<Rating>(rating(rng)), tagId);
+        time += 5 * 60;
+        emit(LogEvent::Rest, 5, Rating::None, tagId);
+        int idle = gapMinutes(rng);
+        time += idle * 60;
+        emit(LogEvent::Idle, static_cast<uint32_t>(idle), Rating::None, tagId);
+        emit(LogEvent::SessionFinished, static_cast<uint32_t>(idle * 60 % 3600), Rating::None, tagId);
+    }
+    all.close();
+    segment.close();
+    uint64_t textBytes = fileSize(allPath);
+    const int64_t lastTime = time;
+
+    auto start = std::chrono::steady_clock::now();
+    LogArchiver::compactAll(logPath);
+    double compactSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t archiveBytes = 0;
+    for (const LogSegment& s : listSegments(logPath)) archiveBytes += fileSize(s.path);
+
+    uint64_t textCount = 0, archiveCount = 0, rangeCount = 0;
+    start = std::chrono::steady_clock::now();
+    forEachLogRecord(allPath, [&](const LogRecord&) { textCount++; });
+    double textSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    forEachHistoryRecord(logPath, [&](const LogRecord&) { archiveCount++; });
+    double archiveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    forEachHistoryRecord(logPath, lastTime - 30 * 86400, INT64_MAX, [&](const LogRecord&, uint64_t) { rangeCount++; });
+    double rangeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1) << textCount << " records in " << sequence << " monthly segments\n"
+              << "text " << textBytes / 1e6 << " MB -> archive " << archiveBytes / 1e6 << " MB ("
+              << static_cast<double>(textBytes) / std::max<uint64_t>(1, archiveBytes) << "x), compacted in "
+              << std::setprecision(2) << compactSeconds << " s\n"
+              << "full scan: text " << textSeconds * 1000 << " ms, archive " << archiveSeconds * 1000 << " ms ("
+              << archiveCount << " records)\n"
+              << "last 30 days: " << rangeSeconds * 1000 << " ms (" << rangeCount << " records)" << std::endl;
+    std::filesystem::remove_all(dir, error);
+    return archiveCount == textCount ? 0 : 1;
+}
+
+} // namespace
+
+int runArchiveCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI archive [status]\n"
+        "       ADHDPomodoro-CLI archive enable [size=64] [monthly]\n"
+        "       ADHDPomodoro-CLI archive disable | rotate | compact\n"
+        "       ADHDPomodoro-CLI archive bench [records=1000000]";
+    const std::string logPath = "log.txt";
+    std::string action = argc > 2 ? argv[2] : "status";
+
+    if (action == "enable") {
+        uint64_t megabytes = 64;
+        bool sizeGiven = false;
+        int monthlyFlag = 0;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.compare(0, 5, "size=") == 0 && parseOptionValue(arg.substr(5), megabytes)) {
+                sizeGiven = true;
+            } else if (arg == "monthly") {
+                monthlyFlag = 1;
+            } else {
+                std::cerr << usage << std::endl;
+                return 1;
+            }
+        }
+        // "enable monthly" alone rotates by month only
+        if (monthlyFlag && !sizeGiven) megabytes = 0;
+        std::ofstream config("rotation.txt");
+        if (!config.is_open()) {
+            std::cerr << "Error: Could not save rotation.txt" << std::endl;
+            return 1;
+        }
+        config << megabytes << " " << monthlyFlag;
+        config.close();
+        printStatus(logPath);
+        return 0;
+    }
+    if (argc > 3 && action != "bench") {
+        std::cerr << usage << std::endl;
+        return 1;
+    }
+    if (action == "status") {
+        printStatus(logPath);
+        return 0;
+    }
+    if (action == "disable") {
+        std::error_code error;
+        std::filesystem::remove("rotation.txt", error);
+        printStatus(logPath);
+        return 0;
+    }
+    if (action == "rotate" || action == "compact") {
+        if (action == "rotate" && fileSize(logPath) > 0 && !LogArchiver::seal(logPath)) return 1;
+        size_t converted = LogArchiver::compactAll(logPath);
+        std::cout << "Compacted " << converted << " segment(s)\n";
+        printStatus(logPath);
+        return 0;
+    }
+    if (action == "bench") {
+        uint64_t records = 1000000;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.compare(0, 8, "records=") == 0 && parseOptionValue(arg.substr(8), records)) {
+                records = std::max<uint64_t>(1, records);
+            } else {
+                std::cerr << usage << std::endl;
+                return 1;
+            }
+        }
+        return runArchiveBench(records);
+    }
+    std::cerr << usage << std::endl;
+    return 1;
+}
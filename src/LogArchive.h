@@ -0,0 +1,106 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * Rotation of log.txt into sealed segments and their columnar archive form.
+ *
+ * With rotation enabled (rotation.txt: "<max MB> <monthly 0|1>"), the
+ * logger seals log.txt as log.<n>.txt when it would grow past the size
+ * limit or a record falls into a new month, and starts a new log.txt.
+ * A low-priority background thread converts every sealed segment into
+ * log.<n>.pla and removes the text:
+ *   header   "PLAR", version, record count
+ *   columns  timestamps   zigzag varint deltas
+ *            events       4 bits per record
+ *            ratings      2 bits per record
+ *            values       varint (minutes or seconds)
+ *            tags         varint
+ *   footer   min/max timestamp, record count, "PLAR"
+ * Each column is prefixed with its byte length. Readers use the footer to
+ * skip segments outside a time range. Lines that do not parse as records
+ * are dropped by the conversion, as every reader skips them anyway.
+ */
+
+struct LogSegment {
+    uint32_t sequence;
+    std::string path;
+    bool archived;      // .pla (otherwise a sealed text segment)
+};
+
+struct ArchiveFooter {
+    int64_t minTime = 0;
+    int64_t maxTime = 0;
+    uint64_t records = 0;
+};
+
+// Sealed segments of a log in sequence order (oldest first)
+std::vector<LogSegment> listSegments(const std::string& logPath);
+std::string segmentPath(const std::string& logPath, uint32_t sequence, bool archived);
+
+// Convert a sealed text segment; the text is removed once the archive is in place
+bool compactSegment(const std::string& textPath, const std::string& archivePath, ArchiveFooter& footer);
+bool readArchiveFooter(const std::string& archivePath, ArchiveFooter& footer);
+bool forEachArchiveRecord(const std::string& archivePath, const std::function<void(const LogRecord&)>& callback);
+// Every record of one sealed segment, text or archive
+bool forEachSegmentRecord(const std::string& logPath, const LogSegment& segment,
+                          const std::function<void(const LogRecord&)>& callback);
+
+/**
+ * Every record of the history (sealed segments, then the live log) whose
+ * timestamp lies in [from, to), in log order. ordinal is the position of the
+ * record in the whole history, also for records of skipped segments.
+ */
+bool forEachHistoryRecord(const std::string& logPath, int64_t from, int64_t to,
+                          const std::function<void(const LogRecord& record, uint64_t ordinal)>& callback);
+bool forEachHistoryRecord(const std::string& logPath, const std::function<void(const LogRecord&)>& callback);
+// Sealed segments only (for readers that follow the live log themselves)
+void forEachSealedRecord(const std::string& logPath, const std::function<void(const LogRecord&)>& callback);
+
+/**
+ * Applies rotation.txt to a logger and compacts sealed segments on a
+ * background thread. Segments left over from earlier runs are compacted
+ * on attach().
+ */
+class LogArchiver {
+public:
+    explicit LogArchiver(const std::string& configPath = "rotation.txt");
+    ~LogArchiver();
+
+    LogArchiver(const LogArchiver&) = delete;
+    LogArchiver& operator=(const LogArchiver&) = delete;
+
+    void attach(SessionLogger& logger);
+
+    uint64_t getMaxBytes() const { return maxBytes; }
+    bool isMonthly() const { return monthly; }
+    bool isEnabled() const { return maxBytes > 0 || monthly; }
+
+    // Move the live log to the next segment number
+    static bool seal(const std::string& logPath);
+    // Compact every sealed text segment now; returns the number converted
+    static size_t compactAll(const std::string& logPath);
+
+private:
+    uint64_t maxBytes;
+    bool monthly;
+    std::string logFilePath;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool pending;
+    bool stopping;
+
+    void run();
+    void schedule();
+};
+
+// "ADHDPomodoro-CLI archive [status] | enable [size=MB] [monthly] | disable | rotate | compact | bench [records=N]"
+int runArchiveCommand(int argc, char* argv[]);
@@ -0,0 +1,305 @@
+#include "LogMerge.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include "SessionLog.h"
+
+namespace {
+
+const size_t bufferSize = 1 << 20;
+
+// Reads one line at a time through a fixed buffer
+class LineReader {
+public:
+    explicit LineReader(const std::string& path)
+        : file(std::fopen(path.c_str(), "rb")), buffer(bufferSize), begin(0), end(0) {}
+    ~LineReader() {
+        if (file) std::fclose(file);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    bool next(std::string& line) {
+        line.clear();
+        while (true) {
+            if (begin == end) {
+                if (!file) return !line.empty();
+                end = std::fread(buffer.data(), 1, buffer.size(), file);
+                begin = 0;
+                if (end == 0) {
+                    std::fclose(file);
+                    file = nullptr;
+                    return !line.empty();
+                }
+            }
+            const char* start = buffer.data() + begin;
+            const char* newline = static_cast<const char*>(std::memchr(start, '\n', end - begin));
+            if (newline) {
+                line.append(start, newline);
+                begin += static_cast<size_t>(newline - start) + 1;
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                return true;
+            }
+            line.append(start, end - begin);
+            begin = end;
+        }
+    }
+
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t begin;
+    size_t end;
+};
+
+// Writes through a fixed buffer
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::string& path) : file(std::fopen(path.c_str(), "wb")) {
+        buffer.reserve(bufferSize);
+    }
+    ~BufferedWriter() {
+        flush();
+        if (file) std::fclose(file);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    void writeLine(const std::string& line) {
+        if (buffer.size() + line.size() + 1 > bufferSize) flush();
+        buffer.append(line);
+        buffer.push_back('\n');
+    }
+
+    void flush() {
+        if (file && !buffer.empty()) std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+
+private:
+    std::FILE* file;
+    std::string buffer;
+};
+
+// Tag names of every input interned into one table; the first input keeps its ids
+class MergedTags {
+public:
+    // Load an input's tags.txt and map its ids; false if it has none
+    bool addInput(const std::string& tagsPath, std::vector<uint32_t>& idMap) {
+        idMap.assign(1, 0);
+        std::ifstream file(tagsPath);
+        if (!file.is_open()) return false;
+        std::string name;
+        while (std::getline(file, name)) {
+            if (!name.empty() && name.back() == '\r') name.pop_back();
+            auto it = ids.find(name);
+            if (it == ids.end()) {
+                it = ids.emplace(name, static_cast<uint32_t>(names.size() + 1)).first;
+                names.push_back(name);
+            }
+            idMap.push_back(it->second);
+        }
+        return true;
+    }
+
+    bool empty() const { return names.empty(); }
+
+    bool save(const std::string& path) const {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            if (!file.is_open()) return false;
+            for (const std::string& name : names) file << name << "\n";
+            if (!file) return false;
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+
+private:
+    std::vector<std::string> names;                 // id - 1
+    std::unordered_map<std::string, uint32_t> ids;
+};
+
+// Rewrite the " [#id]" suffix of a line through an input's id map; false if the id is unknown
+bool remapTag(std::string& line, const std::vector<uint32_t>& idMap) {
+    if (line.size() < 27 || line.back() != ']') return true;
+    size_t open = line.rfind(" [#");
+    if (open == std::string::npos || open < 22) return true;
+    uint32_t id = 0;
+    size_t pos = open + 3;
+    if (pos == line.size() - 1) return true;
+    for (; pos < line.size() - 1; ++pos) {
+        if (line[pos] < '0' || line[pos] > '9') return true;
+        id = id * 10 + static_cast<uint32_t>(line[pos] - '0');
+    }
+    line.resize(open);
+    if (id >= idMap.size()) return false;
+    line += " [#";
+    line += std::to_string(idMap[id]);
+    line += "]";
+    return true;
+}
+
+bool samePath(const std::string& a, const std::string& b) {
+    std::error_code error;
+    if (std::filesystem::exists(a, error) && std::filesystem::exists(b, error)) {
+        return std::filesystem::equivalent(a, b, error);
+    }
+    return std::filesystem::weakly_canonical(a, error) == std::filesystem::weakly_canonical(b, error);
+}
+
+struct HeapEntry {
+    int64_t timestamp;
+    size_t input;
+};
+
+} // namespace
+
+std::string tagsPathFor(const std::string& logPath) {
+    return (std::filesystem::path(logPath).parent_path() / "tags.txt").string();
+}
+
+bool mergeLogs(const std::vector<std::string>& inputs, const std::string& outputPath, const std::string& tagsOutputPath,
+               MergeStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::unique_ptr<LineReader>> readers;
+    std::vector<std::string> current(inputs.size());
+    std::vector<int64_t> lastTimestamp(inputs.size(), INT64_MIN);
+    MergedTags tags;
+    std::vector<std::vector<uint32_t>> idMaps(inputs.size());
+    for (size_t input = 0; input < inputs.size(); ++input) {
+        readers.push_back(std::make_unique<LineReader>(inputs[input]));
+        if (!readers.back()->isOpen()) {
+            std::cerr << "Error: Could not open " << inputs[input] << std::endl;
+            return false;
+        }
+        if (!tags.addInput(tagsPathFor(inputs[input]), idMaps[input])) {
+            std::cerr << "Warning: No tags.txt next to " << inputs[input] << ", its tags are dropped" << std::endl;
+        }
+    }
+    BufferedWriter writer(outputPath);
+    if (!writer.isOpen()) {
+        std::cerr << "Error: Could not create " << outputPath << std::endl;
+        return false;
+    }
+
+    // Order by timestamp, then by line text so equal lines meet at the top of the heap
+    auto later = [&current](const HeapEntry& a, const HeapEntry& b) {
+        if (a.timestamp != b.timestamp) return a.timestamp > b.timestamp;
+        return current[a.input] > current[b.input];
+    };
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(later)> heap(later);
+
+    auto advance = [&](size_t input) {
+        while (readers[input]->next(current[input])) {
+            stats.linesRead++;
+            int64_t timestamp;
+            if (current[input].size() < 19 || !parseEpoch(current[input].data(), 19, timestamp)) {
+                stats.skipped++;
+                continue;
+            }
+            if (!remapTag(current[input], idMaps[input])) stats.unknownTags++;
+            if (timestamp < lastTimestamp[input]) stats.outOfOrder++;
+            lastTimestamp[input] = timestamp;
+            heap.push(HeapEntry{ timestamp, input });
+            return;
+        }
+    };
+
+    for (size_t input = 0; input < readers.size(); ++input) {
+        advance(input);
+    }
+
+    // Lines already written for the current timestamp
+    int64_t emittedTimestamp = INT64_MIN;
+    std::unordered_set<std::string> emitted;
+
+    while (!heap.empty()) {
+        HeapEntry top = heap.top();
+        heap.pop();
+
+        if (top.timestamp != emittedTimestamp) {
+            emittedTimestamp = top.timestamp;
+            emitted.clear();
+        }
+        if (emitted.insert(current[top.input]).second) {
+            writer.writeLine(current[top.input]);
+            stats.linesWritten++;
+        } else {
+            stats.duplicates++;
+        }
+        advance(top.input);
+    }
+    writer.flush();
+
+    if (!tags.empty() && !tags.save(tagsOutputPath)) {
+        std::cerr << "Error: Could not write " << tagsOutputPath << std::endl;
+        return false;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+int runMergeCommand(int argc, char* argv[]) {
+    std::vector<std::string> inputs;
+    std::string output;
+    std::string tagsOutput;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--tags" && i + 1 < argc) {
+            tagsOutput = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty() || output.empty()) {
+        std::cerr << "Usage: ADHDPomodoro-CLI merge a.txt b.txt ... -o merged.txt [--tags merged-tags.txt]" << std::endl;
+        return 1;
+    }
+    if (tagsOutput.empty()) {
+        tagsOutput = tagsPathFor(output);
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (samePath(inputs[i], output) || samePath(inputs[i], tagsOutput)) {
+            std::cerr << "Error: Output file must differ from the inputs" << std::endl;
+            return 1;
+        }
+        // The first input keeps its ids, so only its tag table may be replaced by the merged one
+        if (i > 0 && samePath(tagsPathFor(inputs[i]), tagsOutput)) {
+            std::cerr << "Error: " << tagsOutput << " belongs to " << inputs[i]
+                      << "; write the merged tags elsewhere with --tags FILE" << std::endl;
+            return 1;
+        }
+    }
+
+    MergeStats stats;
+    if (!mergeLogs(inputs, output, tagsOutput, stats)) {
+        return 1;
+    }
+
+    std::cout << "Merged " << inputs.size() << " file(s): " << stats.linesRead << " lines read, "
+              << stats.linesWritten << " written, " << stats.duplicates << " duplicates removed";
+    if (stats.skipped > 0) std::cout << ", " << stats.skipped << " lines without timestamp skipped";
+    std::cout << "\n";
+    if (stats.unknownTags > 0) {
+        std::cout << "Warning: " << stats.unknownTags << " lines referenced tag ids missing from their tags.txt; the tag was removed\n";
+    }
+    if (stats.outOfOrder > 0) {
+        std::cout << "Warning: " << stats.outOfOrder << " lines were older than the line before them in the same input\n";
+    }
+    double rate = stats.seconds > 0 ? stats.linesRead / stats.seconds : 0;
+    std::cout << stats.seconds << " s, " << static_cast<uint64_t>(rate) << " records/sec" << std::endl;
+    return 0;
+}
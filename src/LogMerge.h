@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Streaming k-way merge of log files written on different machines.
+ *
+ * Every input is read once through a fixed-size buffer and is expected to be
+ * in time order (as log.txt is appended). A min-heap on (timestamp, line)
+ * picks the next line; identical lines with the same timestamp are written
+ * once. Memory use depends on the number of inputs, not their size.
+ *
+ * Tag ids are local to each machine's tags.txt (read from the input's
+ * directory). The tables are interned into one merged table, keeping the
+ * ids of the first input, and every " [#id]" suffix is rewritten to the
+ * merged id before duplicates are compared.
+ */
+struct MergeStats {
+    uint64_t linesRead = 0;
+    uint64_t linesWritten = 0;
+    uint64_t duplicates = 0;
+    uint64_t skipped = 0;       // lines without a timestamp
+    uint64_t outOfOrder = 0;    // lines older than their predecessor in the same input
+    uint64_t unknownTags = 0;   // tag ids missing from their input's tags.txt (tag dropped)
+    double seconds = 0;
+};
+
+// tags.txt in the directory of a log file
+std::string tagsPathFor(const std::string& logPath);
+
+bool mergeLogs(const std::vector<std::string>& inputs, const std::string& outputPath, const std::string& tagsOutputPath,
+               MergeStats& stats);
+
+// "ADHDPomodoro-CLI merge a.txt b.txt ... -o merged.txt [--tags FILE]"
+int runMergeCommand(int argc, char* argv[]);
@@ -0,0 +1,118 @@
+#include "PomodoroManager.h"
+
+const char* stateName(State state) {
+    switch (state) {
+        case State::Focus: return "focus";
+        case State::ExtendedFocus: return "extendedfocus";
+        case State::Rest: return "rest";
+        case State::Hyperfocus: return "hyperfocus";
+        case State::IdleAfterRest: return "idle";
+    }
+    return "unknown";
+}
+
+PomodoroManager::PomodoroManager(SessionLogger& logger, int focusMinutes, int restMinutes)
+    : logger(logger), focusDuration(focusMinutes), restDuration(restMinutes),
+      startTime(Clock::now()), pauseTime(Clock::now()), currentState(State::Focus),
+      elapsedSeconds(0), totalFocusTime(0), isTimerRunning(false), isPaused(false) {}
+
+void PomodoroManager::enter(State state, TimePoint now) {
+    currentState = state;
+    startTime = now;
+    elapsedSeconds = 0;
+}
+
+void PomodoroManager::update(TimePoint now) {
+    // Update timer only if running and not paused
+    if (!isTimerRunning || isPaused) return;
+
+    elapsedSeconds = static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count());
+
+    switch (currentState) {
+        case State::Focus: {
+            int remaining = focusDuration * 60 - elapsedSeconds;
+            if (remaining <= 0) {
+                totalFocusTime = focusDuration * 60;
+                enter(State::ExtendedFocus, now);
+            }
+            break;
+        }
+        case State::ExtendedFocus:
+        case State::Hyperfocus:
+            totalFocusTime = focusDuration * 60 + elapsedSeconds;
+            break;
+        case State::Rest: {
+            int remaining = restDuration * 60 - elapsedSeconds;
+            if (remaining <= 0) {
+                enter(State::IdleAfterRest, now);
+            }
+            break;
+        }
+        case State::IdleAfterRest:
+            // Just count up
+            break;
+    }
+}
+
+bool PomodoroManager::start(TimePoint now) {
+    if (isTimerRunning) return false;
+    isTimerRunning = true;
+    isPaused = false;
+    enter(State::Focus, now);
+    totalFocusTime = 0;
+    logger.log(LogEvent::SessionStarted);
+    return true;
+}
+
+bool PomodoroManager::togglePause(TimePoint now) {
+    if (!isTimerRunning) return false;
+    if (isPaused) {
+        isPaused = false;
+        startTime += (now - pauseTime);
+        logger.log(LogEvent::SessionResumed);
+    } else {
+        isPaused = true;
+        pauseTime = now;
+        logger.log(LogEvent::SessionPaused, static_cast<uint32_t>(elapsedSeconds));
+    }
+    return true;
+}
+
+bool PomodoroManager::finish(TimePoint now) {
+    if (!isTimerRunning) return false;
+    if (currentState == State::Rest || currentState == State::IdleAfterRest) {
+        // Start new focus session
+        enter(State::Focus, now);
+        totalFocusTime = 0;
+        isPaused = false;
+        logger.log(LogEvent::NewFocus);
+    } else {
+        // Finish current session
+        isTimerRunning = false;
+        isPaused = false;
+        logger.log(LogEvent::SessionFinished, static_cast<uint32_t>(elapsedSeconds));
+        logger.setTag(0);
+    }
+    return true;
+}
+
+bool PomodoroManager::rate(Rating rating, TimePoint now) {
+    if (currentState != State::ExtendedFocus || rating == Rating::None) return false;
+    enter(State::Rest, now);
+    logger.log(LogEvent::Focus, static_cast<uint32_t>(totalFocusTime / 60), rating);
+    return true;
+}
+
+bool PomodoroManager::enterHyperfocus() {
+    if (currentState != State::ExtendedFocus) return false;
+    currentState = State::Hyperfocus;
+    logger.log(LogEvent::EnteredHyperfocus);
+    return true;
+}
+
+bool PomodoroManager::rest(TimePoint now) {
+    if (currentState != State::Hyperfocus) return false;
+    enter(State::Rest, now);
+    logger.log(LogEvent::Hyperfocus, static_cast<uint32_t>(totalFocusTime / 60));
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <chrono>
+#include "SessionLog.h"
+
+// Timer states
+enum class State {
+    Focus,
+    ExtendedFocus,
+    Rest,
+    Hyperfocus,
+    IdleAfterRest
+};
+
+const char* stateName(State state);
+
+/**
+ * Timer state machine of the CLI version.
+ *
+ * All transitions take the current time as an argument instead of reading
+ * the clock, so the same logic drives the interactive loop, the headless
+ * protocol and simulations with a virtual clock. Transitions are written to
+ * the session log.
+ */
+class PomodoroManager {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    PomodoroManager(SessionLogger& logger, int focusMinutes, int restMinutes);
+
+    void setFocusDuration(int minutes) { focusDuration = minutes; }
+    void setRestDuration(int minutes) { restDuration = minutes; }
+    int getFocusDuration() const { return focusDuration; }
+    int getRestDuration() const { return restDuration; }
+
+    // Advance timers; handles Focus -> ExtendedFocus and Rest -> IdleAfterRest
+    void update(TimePoint now);
+
+    // Commands return false when they do not apply in the current state
+    bool start(TimePoint now);
+    bool togglePause(TimePoint now);
+    bool finish(TimePoint now);         // finish the session, or start focus from Rest/Idle
+    bool rate(Rating rating, TimePoint now);
+    bool enterHyperfocus();
+    bool rest(TimePoint now);           // leave Hyperfocus
+
+    State getState() const { return currentState; }
+    int getElapsedSeconds() const { return elapsedSeconds; }
+    int getTotalFocusTime() const { return totalFocusTime; }
+    bool isRunning() const { return isTimerRunning; }
+    bool isPausedNow() const { return isPaused; }
+
+private:
+    SessionLogger& logger;
+    int focusDuration;      // in minutes
+    int restDuration;       // in minutes
+
+    TimePoint startTime;
+    TimePoint pauseTime;
+    State currentState;
+    int elapsedSeconds;
+    int totalFocusTime;
+    bool isTimerRunning;
+    bool isPaused;
+
+    void enter(State state, TimePoint now);
+};
@@ -0,0 +1,491 @@
+#include "QualityModel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "LogArchive.h"
+#include "TagTable.h"
+
+namespace {
+
+const char modelMagic[4] = { 'P', 'Q', 'L', 'M' };
+const uint32_t modelVersion = 1;
+
+const double learningRate = 0.2;
+const double regularization = 1e-4;
+const int64_t maxBreakSeconds = 3 * 3600;   // a longer break starts a new session
+const int tagBuckets = 16;
+
+// Feature layout
+const int hourBlockFeature = 1;             // 8 three-hour blocks
+const int weekdayFeature = 9;               // 7 days, Sunday first
+const int focusFeature = 16;                // log length, squared
+const int restFeature = 18;                 // log length, squared
+const int previousFocusFeature = 20;
+const int idleFeature = 21;
+const int firstFeature = 22;
+const int tagFeature = 23;                  // 16 buckets, 0 = untagged
+
+void features(const QualityModel::Context& context, int focusMinutes, double* x) {
+    std::fill(x, x + QualityModel::featureCount, 0.0);
+    x[0] = 1;
+    int64_t secondOfDay = ((context.start % 86400) + 86400) % 86400;
+    x[hourBlockFeature + secondOfDay / 10800] = 1;
+    x[weekdayFeature + ((epochDay(context.start) + 4) % 7 + 7) % 7] = 1;
+    double focus = std::log(std::max(1, focusMinutes) / 25.0);
+    x[focusFeature] = focus;
+    x[focusFeature + 1] = focus * focus;
+    double rest = std::log((1.0 + context.rest) / 6.0);
+    x[restFeature] = rest;
+    x[restFeature + 1] = rest * rest;
+    x[previousFocusFeature] = std::log((1.0 + context.previousFocus) / 26.0);
+    x[idleFeature] = std::log1p(static_cast<double>(context.idle)) / std::log(61.0);
+    x[firstFeature] = context.first ? 1 : 0;
+    x[tagFeature + (context.tagId == 0 ? 0 : 1 + (context.tagId - 1) % (tagBuckets - 1))] = 1;
+}
+
+double sigmoid(double z) {
+    return 1 / (1 + std::exp(-z));
+}
+
+template <typename T>
+void writeValue(std::FILE* file, T value) {
+    std::fwrite(&value, sizeof(value), 1, file);
+}
+
+template <typename T>
+bool readValue(std::FILE* file, T& value) {
+    return std::fread(&value, sizeof(value), 1, file) == 1;
+}
+
+// Candidate durations: every minute up to 10, then steps of 5, within half to twice the
+// configured length (half rounded up), the lengths seen so far and [1, limit]
+std::vector<int> candidates(uint32_t low, uint32_t high, int configured, int limit) {
+    int from = std::max({ 1, static_cast<int>(low), (configured + 1) / 2 });
+    int to = std::min({ limit, static_cast<int>(high), configured * 2 });
+    std::vector<int> values;
+    for (int minutes = 1; minutes <= to; minutes += minutes < 10 ? 1 : 5) {
+        if (minutes >= from) values.push_back(minutes);
+    }
+    if (values.empty()) values.push_back(configured);
+    return values;
+}
+
+} // namespace
+
+QualityModel::QualityModel(const std::string& path, const std::string& logPath)
+    : modelFilePath(path), logFilePath(logPath) {
+    clear();
+    load(modelFilePath);
+}
+
+void QualityModel::clear() {
+    std::fill(weights, weights + featureCount, 0.0);
+    std::fill(squaredGradients, squaredGradients + featureCount, 0.0);
+    samples = 0;
+    good = 0;
+    focusLow = focusHigh = 0;
+    restLow = restHigh = 0;
+    sessionOpen = false;
+    lastFocusEnd = 0;
+    lastFocusMinutes = 0;
+    loggedRest = 0;
+    loggedIdle = 0;
+}
+
+bool QualityModel::add(const LogRecord& record) {
+    switch (record.event) {
+        case LogEvent::SessionStarted:
+            sessionOpen = true;
+            lastFocusEnd = 0;
+            lastFocusMinutes = 0;
+            loggedRest = 0;
+            loggedIdle = 0;
+            return true;
+        case LogEvent::SessionFinished:
+        case LogEvent::Quit:
+            sessionOpen = false;
+            return true;
+        case LogEvent::Rest:
+            loggedRest = record.value;
+            return true;
+        case LogEvent::Idle:
+            loggedIdle = record.value;
+            return true;
+        case LogEvent::Focus:
+        case LogEvent::Hyperfocus: {
+            if (record.event == LogEvent::Focus && record.rating == Rating::None) return false;
+            Context context = contextAt(record.timestamp - static_cast<int64_t>(record.value) * 60, record.tagId);
+            // A hyperfocus block's length includes the hyperfocus, so training on it as Good
+            // would only teach that long blocks are good; it still counts as preceding focus
+            if (record.event == LogEvent::Focus) {
+                train(context, record.value, record.rating == Rating::Good);
+                if (record.value > 0) {
+                    focusLow = focusLow == 0 ? record.value : std::min(focusLow, record.value);
+                    focusHigh = std::max(focusHigh, record.value);
+                }
+                if (!context.first && context.rest > 0) {
+                    restLow = restLow == 0 ? context.rest : std::min(restLow, context.rest);
+                    restHigh = std::max(restHigh, context.rest);
+                }
+            }
+            sessionOpen = true;
+            lastFocusEnd = record.timestamp;
+            lastFocusMinutes = record.value;
+            loggedRest = 0;
+            loggedIdle = 0;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool QualityModel::backfill() {
+    if (modelFilePath.empty()) return false;
+    std::error_code error;
+    if (std::filesystem::exists(modelFilePath, error)) return false;
+    rebuild(logFilePath);
+    save();
+    return true;
+}
+
+void QualityModel::train(const Context& context, uint32_t focusMinutes, bool isGood) {
+    double x[featureCount];
+    features(context, static_cast<int>(focusMinutes), x);
+    double z = 0;
+    for (int i = 0; i < featureCount; ++i) z += weights[i] * x[i];
+    double error = sigmoid(z) - (isGood ? 1 : 0);
+    for (int i = 0; i < featureCount; ++i) {
+        double gradient = error * x[i] + regularization * weights[i];
+        squaredGradients[i] += gradient * gradient;
+        if (squaredGradients[i] > 0) {
+            weights[i] -= learningRate * gradient / std::sqrt(squaredGradients[i]);
+        }
+    }
+    ++samples;
+    if (isGood) ++good;
+}
+
+QualityModel::Context QualityModel::contextAt(int64_t now, uint32_t tagId) const {
+    Context context;
+    context.start = now;
+    context.tagId = tagId;
+    if (sessionOpen && lastFocusEnd > 0 && now >= lastFocusEnd && now - lastFocusEnd <= maxBreakSeconds) {
+        // The GUI logs rest and idle; the CLI only leaves the gap between two focus blocks
+        uint32_t gap = static_cast<uint32_t>((now - lastFocusEnd) / 60);
+        context.first = false;
+        context.previousFocus = lastFocusMinutes;
+        context.rest = loggedRest > 0 ? loggedRest : (gap > loggedIdle ? gap - loggedIdle : 0);
+        context.idle = loggedIdle;
+    }
+    return context;
+}
+
+double QualityModel::predict(const Context& context, int focusMinutes) const {
+    double x[featureCount];
+    features(context, focusMinutes, x);
+    double z = 0;
+    for (int i = 0; i < featureCount; ++i) z += weights[i] * x[i];
+    return sigmoid(z);
+}
+
+QualityModel::Suggestion QualityModel::suggest(int64_t now, uint32_t tagId, int focusMinutes, int restMinutes) const {
+    Suggestion suggestion;
+    Context context = contextAt(now, tagId);
+    suggestion.focusMinutes = focusMinutes;
+    suggestion.restMinutes = restMinutes;
+    suggestion.current = predict(context, focusMinutes);
+    suggestion.probability = suggestion.current;
+    if (samples < minimumSamples) return suggestion;
+    suggestion.ready = true;
+
+    // Keep the configured focus unless another length is clearly better
+    for (int minutes : candidates(focusLow, focusHigh, focusMinutes, 90)) {
+        double p = predict(context, minutes);
+        if (p > suggestion.probability + 0.01) {
+            suggestion.probability = p;
+            suggestion.focusMinutes = minutes;
+        }
+    }
+
+    // The rest pays off in the block after it
+    Context next;
+    next.tagId = tagId;
+    next.first = false;
+    next.previousFocus = static_cast<uint32_t>(suggestion.focusMinutes);
+    double bestNext = -1;
+    for (int minutes : candidates(restLow, restHigh, restMinutes, 30)) {
+        next.start = now + static_cast<int64_t>(suggestion.focusMinutes + minutes) * 60;
+        next.rest = static_cast<uint32_t>(minutes);
+        double p = predict(next, suggestion.focusMinutes);
+        if (p > bestNext) {
+            bestNext = p;
+            suggestion.restMinutes = minutes;
+        }
+    }
+    return suggestion;
+}
+
+bool QualityModel::save() const {
+    std::FILE* file = std::fopen(modelFilePath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not save " << modelFilePath << std::endl;
+        return false;
+    }
+    std::fwrite(modelMagic, 1, sizeof(modelMagic), file);
+    writeValue<uint32_t>(file, modelVersion);
+    writeValue<uint32_t>(file, featureCount);
+    std::fwrite(weights, sizeof(double), featureCount, file);
+    std::fwrite(squaredGradients, sizeof(double), featureCount, file);
+    writeValue(file, samples);
+    writeValue(file, good);
+    writeValue(file, focusLow);
+    writeValue(file, focusHigh);
+    writeValue(file, restLow);
+    writeValue(file, restHigh);
+    writeValue<uint8_t>(file, sessionOpen ? 1 : 0);
+    writeValue(file, lastFocusEnd);
+    writeValue(file, lastFocusMinutes);
+    writeValue(file, loggedRest);
+    writeValue(file, loggedIdle);
+    std::fclose(file);
+    return true;
+}
+
+bool QualityModel::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    uint8_t open = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, modelMagic, sizeof(magic)) == 0 &&
+              readValue(file, version) && version == modelVersion &&
+              readValue(file, count) && count == featureCount &&
+              std::fread(weights, sizeof(double), featureCount, file) == featureCount &&
+              std::fread(squaredGradients, sizeof(double), featureCount, file) == featureCount &&
+              readValue(file, samples) && readValue(file, good) &&
+              readValue(file, focusLow) && readValue(file, focusHigh) &&
+              readValue(file, restLow) && readValue(file, restHigh) &&
+              readValue(file, open) && readValue(file, lastFocusEnd) && readValue(file, lastFocusMinutes) &&
+              readValue(file, loggedRest) && readValue(file, loggedIdle);
+    std::fclose(file);
+    sessionOpen = open != 0;
+    if (!ok) {
+        std::cerr << "Error: " << path << " is not a valid model file" << std::endl;
+        clear();
+    }
+    return ok;
+}
+
+void QualityModel::rebuild(const std::string& logPath) {
+    clear();
+    forEachHistoryRecord(logPath, [this](const LogRecord& record) { add(record); });
+}
+
+std::string formatSuggestion(const QualityModel::Suggestion& suggestion, int focusMinutes, int restMinutes) {
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(0);
+    if (!suggestion.ready) {
+        line << "Suggestions after " << QualityModel::minimumSamples << " rated sessions";
+        return line.str();
+    }
+    line << "Suggested: Focus " << suggestion.focusMinutes << " min, Rest " << suggestion.restMinutes
+         << " min (P(Good) " << suggestion.probability * 100 << "%";
+    if (suggestion.focusMinutes != focusMinutes || suggestion.restMinutes != restMinutes) {
+        line << ", " << suggestion.current * 100 << "% with " << focusMinutes << "/" << restMinutes;
+    }
+    line << ")";
+    return line.str();
+}
+
+namespace {
+
+/**
+ * Train on synthetic days whose true P(Good) peaks at 35 min focus, is
+ * higher in the morning and lower late at night and for one tag, then
+ * compare the log loss on the last fifth with always predicting the base
+ * rate. Also reports the cost of one update and one suggestion.
+ */
+int runModelBench(size_t sampleCount) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> focusDraw(10, 60);
+    std::uniform_int_distribution<int> restDraw(2, 15);
+    std::uniform_int_distribution<int> hourDraw(7, 22);
+    std::uniform_int_distribution<int> tagDraw(0, 3);
+    std::uniform_real_distribution<double> unit(0, 1);
+    auto truth = [](int hour, int focus, int rest, uint32_t tag) {
+        double f = std::log(focus / 35.0);
+        double r = std::log(rest / 6.0);
+        double z = 0.4 - 4 * f * f - 0.8 * r * r + (hour < 12 ? 0.8 : 0) - (hour >= 20 ? 1.0 : 0) -
+                   (tag == 3 ? 1.2 : 0);
+        return 1 / (1 + std::exp(-z));
+    };
+
+    // Records of one session per synthetic day, 1-4 blocks each
+    std::vector<LogRecord> records;
+    std::vector<double> truthOfRecord;
+    int64_t day = civilToEpoch(2024, 1, 1);
+    size_t blocks = 0;
+    while (blocks < sampleCount) {
+        int hour = hourDraw(rng);
+        uint32_t tag = static_cast<uint32_t>(tagDraw(rng));
+        int64_t t = day + hour * 3600;
+        LogRecord started;
+        started.timestamp = t;
+        started.event = LogEvent::SessionStarted;
+        started.tagId = tag;
+        records.push_back(started);
+        truthOfRecord.push_back(-1);
+        int rest = 0;
+        int count = 1 + static_cast<int>(unit(rng) * 4);
+        for (int i = 0; i < count && blocks < sampleCount; ++i, ++blocks) {
+            int focus = focusDraw(rng);
+            t += static_cast<int64_t>(rest + focus) * 60;
+            int blockHour = static_cast<int>(((t - focus * 60) % 86400) / 3600);
+            double p = truth(blockHour, focus, i == 0 ? 6 : rest, tag);
+            LogRecord rated;
+            rated.timestamp = t;
+            rated.event = LogEvent::Focus;
+            rated.value = static_cast<uint32_t>(focus);
+            rated.rating = unit(rng) < p ? Rating::Good : (unit(rng) < 0.5 ? Rating::Okay : Rating::Bad);
+            rated.tagId = tag;
+            records.push_back(rated);
+            truthOfRecord.push_back(p);
+            rest = restDraw(rng);
+        }
+        LogRecord finished;
+        finished.timestamp = t + rest * 60;
+        finished.event = LogEvent::SessionFinished;
+        finished.tagId = tag;
+        records.push_back(finished);
+        truthOfRecord.push_back(-1);
+        day += 86400;
+    }
+
+    QualityModel model("");
+    size_t testFrom = blocks * 4 / 5;
+    size_t seen = 0;
+    double modelLoss = 0, baseLoss = 0, truthLoss = 0;
+    size_t tested = 0, trainGood = 0;
+    auto start = std::chrono::steady_clock::now();
+    double predictSeconds = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        const LogRecord& record = records[i];
+        if (record.event == LogEvent::Focus && seen++ >= testFrom) {
+            // Score before the model learns from it
+            auto predictStart = std::chrono::steady_clock::now();
+            QualityModel::Context context =
+                model.contextAt(record.timestamp - static_cast<int64_t>(record.value) * 60, record.tagId);
+            double p = std::min(std::max(model.predict(context, static_cast<int>(record.value)), 1e-6), 1 - 1e-6);
+            predictSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - predictStart).count();
+            double base = std::min(std::max(static_cast<double>(trainGood) / testFrom, 1e-6), 1 - 1e-6);
+            bool isGood = record.rating == Rating::Good;
+            modelLoss -= std::log(isGood ? p : 1 - p);
+            baseLoss -= std::log(isGood ? base : 1 - base);
+            truthLoss -= std::log(isGood ? truthOfRecord[i] : 1 - truthOfRecord[i]);
+            ++tested;
+        } else if (record.event == LogEvent::Focus && record.rating == Rating::Good) {
+            ++trainGood;
+        }
+        model.add(record);
+    }
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const int suggestRuns = 10000;
+    int64_t morning = day + 9 * 3600;
+    QualityModel::Suggestion suggestion;
+    auto suggestStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < suggestRuns; ++i) suggestion = model.suggest(morning + i % 60, 1, 25, 5);
+    double suggestUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - suggestStart).count() /
+                       suggestRuns;
+
+    std::cout << blocks << " rated blocks (" << records.size() << " records), tested on the last " << tested << "\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "update:  " << (totalSeconds - predictSeconds) / records.size() * 1e9 << " ns/record\n"
+              << "suggest: " << suggestUs << " us (" << QualityModel::featureCount << " features)\n"
+              << std::setprecision(4)
+              << "log loss: model " << modelLoss / tested << ", base rate " << baseLoss / tested
+              << ", true probabilities " << truthLoss / tested << "\n"
+              << "suggestion at 09:00: " << formatSuggestion(suggestion, 25, 5) << " (true optimum 35/6)\n";
+    return 0;
+}
+
+} // namespace
+
+int runModelCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI model [show] [--rebuild] [tag=NAME] [focus=N] [rest=N]\n"
+        "       ADHDPomodoro-CLI model bench [samples=100000]";
+    bool rebuild = false;
+    std::string tagName;
+    // Durations to compare with, settings.txt by default (same defaults as both timers)
+    int focusMinutes = 10, restMinutes = 5;
+    std::ifstream settingsFile("settings.txt");
+    if (settingsFile.is_open()) settingsFile >> focusMinutes >> restMinutes;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "bench") {
+            size_t samples = 100000;
+            for (int j = i + 1; j < argc; ++j) {
+                std::string option = argv[j];
+                if (option.compare(0, 8, "samples=") == 0 && parseOptionValue(option.substr(8), samples)) {
+                    samples = std::max<size_t>(100, samples);
+                } else {
+                    std::cerr << usage << std::endl;
+                    return 1;
+                }
+            }
+            return runModelBench(samples);
+        } else if (arg == "show") {
+        } else if (arg == "--rebuild") {
+            rebuild = true;
+        } else if (arg.compare(0, 4, "tag=") == 0) {
+            tagName = arg.substr(4);
+        } else if (arg.compare(0, 6, "focus=") == 0 && parseOptionValue(arg.substr(6), focusMinutes)) {
+            focusMinutes = std::max(1, focusMinutes);
+        } else if (arg.compare(0, 5, "rest=") == 0 && parseOptionValue(arg.substr(5), restMinutes)) {
+            restMinutes = std::max(1, restMinutes);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    QualityModel model;
+    if (rebuild) {
+        model.rebuild("log.txt");
+        if (!model.save()) return 1;
+    } else if (model.backfill()) {
+        std::cout << "Model trained on log.txt\n";
+    }
+    TagTable tags;
+    uint32_t tagId = tags.find(tagName);
+    if (!tagName.empty() && tagId == 0) {
+        std::cerr << "Error: Unknown tag " << tagName << std::endl;
+        return 1;
+    }
+
+    int64_t now = localNow();
+    QualityModel::Context context = model.contextAt(now, tagId);
+    std::cout << model.getSamples() << " rated sessions, " << model.getGood() << " Good\n";
+    std::cout << (context.first ? "Next block starts a session" : "Next block continues the session") << "\n";
+    std::cout << std::fixed << std::setprecision(0);
+    for (int minutes : { 15, 25, 35, 45, 60 }) {
+        std::cout << "  P(Good) now with " << std::setw(2) << minutes << " min focus: "
+                  << std::setw(3) << model.predict(context, minutes) * 100 << "%\n";
+    }
+    std::cout << formatSuggestion(model.suggest(now, tagId, focusMinutes, restMinutes), focusMinutes, restMinutes)
+              << std::endl;
+    return 0;
+}
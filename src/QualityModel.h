@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "SessionLog.h"
+
+/**
+ * Online logistic regression predicting the chance that a focus block is
+ * rated Good rather than Okay or Bad. Hyperfocus blocks are not rated and
+ * only count as preceding focus.
+ *
+ * Features of a block: bias, 3-hour block of the day and weekday of its
+ * start, log focus length and its square, log preceding rest and its
+ * square, preceding focus and idle lengths, first block of the session,
+ * and one of 16 tag buckets. The quadratic terms let the model prefer a
+ * duration in the middle of the range instead of always the longest or
+ * shortest one.
+ *
+ * Every rated record is one AdaGrad step touching each feature once; the
+ * context the next block needs (end of the last focus, logged rest and
+ * idle) is tracked from the records in between. Weights, step sizes and
+ * context are stored in quality.bin (under 1 KB), so the history is never
+ * read again after a rating. A missing quality.bin is trained once from
+ * the existing history.
+ */
+class QualityModel {
+public:
+    static const int featureCount = 39;
+
+    // What is known about a focus block before it starts
+    struct Context {
+        int64_t start = 0;              // local epoch seconds
+        uint32_t tagId = 0;
+        bool first = true;              // first block of the session
+        uint32_t previousFocus = 0;     // minutes
+        uint32_t rest = 0;
+        uint32_t idle = 0;
+    };
+
+    struct Suggestion {
+        bool ready = false;             // enough rated blocks to suggest durations
+        int focusMinutes = 0;
+        int restMinutes = 0;
+        double probability = 0;         // P(Good) with the suggested durations
+        double current = 0;             // P(Good) with the configured durations
+    };
+
+    explicit QualityModel(const std::string& path = "quality.bin", const std::string& logPath = "log.txt");
+
+    // Fold a log record into the context and train on ratings; returns false if nothing changed
+    bool add(const LogRecord& record);
+    // Train on the whole history and save if the file is missing, so ratings already in
+    // the log count from the start; returns true if it trained
+    bool backfill();
+    bool save() const;
+    bool load(const std::string& path);
+    // Retrain from scratch over the whole history (explicit "model --rebuild" only)
+    void rebuild(const std::string& logPath);
+    void clear();
+
+    // Context of a block starting at now, following the tracked session
+    Context contextAt(int64_t now, uint32_t tagId) const;
+    double predict(const Context& context, int focusMinutes) const;
+    // Best focus duration now, and the rest that makes the following block most likely Good.
+    // Only lengths between half and twice the configured ones (and seen before) are considered.
+    Suggestion suggest(int64_t now, uint32_t tagId, int focusMinutes, int restMinutes) const;
+
+    uint32_t getSamples() const { return samples; }
+    uint32_t getGood() const { return good; }
+    static const uint32_t minimumSamples = 20;
+
+private:
+    std::string modelFilePath;
+    std::string logFilePath;
+    double weights[featureCount];
+    double squaredGradients[featureCount];
+    uint32_t samples;
+    uint32_t good;
+    // Range of durations seen, the suggestions stay inside it
+    uint32_t focusLow, focusHigh;
+    uint32_t restLow, restHigh;
+
+    // Tracked context
+    bool sessionOpen;
+    int64_t lastFocusEnd;
+    uint32_t lastFocusMinutes;
+    uint32_t loggedRest;
+    uint32_t loggedIdle;
+
+    void train(const Context& context, uint32_t focusMinutes, bool isGood);
+};
+
+// "ADHDPomodoro-CLI model [show] [--rebuild] | model bench [samples=N]"
+int runModelCommand(int argc, char* argv[]);
+
+// One line for the Ready screen, e.g. "Suggested: Focus 30 min, Rest 5 min (P(Good) 64%, 51% with 25/5)"
+std::string formatSuggestion(const QualityModel::Suggestion& suggestion, int focusMinutes, int restMinutes);
@@ -0,0 +1,379 @@
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include "LogArchive.h"
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+const char sketchMagic[4] = { 'P', 'Q', 'S', 'K' };
+const uint32_t sketchVersion = 1;
+
+// k1 scale function: centroid size limit shrinks towards q = 0 and q = 1
+double scale(double q, double compression) {
+    return compression / (2 * pi) * std::asin(2 * q - 1);
+}
+
+// Largest quantile a centroid starting at q may reach
+double nextLimit(double q, double compression) {
+    double angle = (scale(q, compression) + 1) * 2 * pi / compression;
+    if (angle >= pi / 2) return 1;
+    return (std::sin(angle) + 1) / 2;
+}
+
+template <typename T>
+void writeValue(std::FILE* file, T value) {
+    std::fwrite(&value, sizeof(value), 1, file);
+}
+
+template <typename T>
+bool readValue(std::FILE* file, T& value) {
+    return std::fread(&value, sizeof(value), 1, file) == 1;
+}
+
+} // namespace
+
+QuantileSketch::QuantileSketch(double compression)
+    : compression(compression), totalWeight(0), bufferedWeight(0),
+      minValue(std::numeric_limits<double>::infinity()), maxValue(-std::numeric_limits<double>::infinity()) {}
+
+void QuantileSketch::add(double value, double weight) {
+    if (!(weight > 0) || std::isnan(value)) return;
+    buffer.push_back(Centroid{ value, weight });
+    bufferedWeight += weight;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    if (buffer.size() >= static_cast<size_t>(compression) * 5) compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    other.compress();
+    for (const Centroid& c : other.centroids) {
+        buffer.push_back(c);
+        bufferedWeight += c.weight;
+    }
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    compress();
+}
+
+void QuantileSketch::compress() const {
+    if (buffer.empty()) return;
+
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+    std::sort(buffer.begin(), buffer.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    double total = totalWeight + bufferedWeight;
+
+    centroids.clear();
+    Centroid current = buffer[0];
+    double soFar = 0;
+    double limit = total * nextLimit(0, compression);
+    for (size_t i = 1; i < buffer.size(); ++i) {
+        const Centroid& next = buffer[i];
+        if (soFar + current.weight + next.weight <= limit) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        } else {
+            soFar += current.weight;
+            centroids.push_back(current);
+            limit = total * nextLimit(soFar / total, compression);
+            current = next;
+        }
+    }
+    centroids.push_back(current);
+
+    buffer.clear();
+    totalWeight = total;
+    bufferedWeight = 0;
+}
+
+size_t QuantileSketch::centroidCount() const {
+    compress();
+    return centroids.size();
+}
+
+double QuantileSketch::quantile(double q) const {
+    compress();
+    if (centroids.empty()) return std::numeric_limits<double>::quiet_NaN();
+    if (q <= 0) return minValue;
+    if (q >= 1) return maxValue;
+    if (centroids.size() == 1) return centroids[0].mean;
+
+    // Interpolate between centroid centres; the outer halves reach min and max
+    double index = q * totalWeight;
+    const Centroid& first = centroids.front();
+    if (index < first.weight / 2) {
+        return minValue + (first.mean - minValue) * index / (first.weight / 2);
+    }
+    double cumulative = first.weight / 2;
+    for (size_t i = 0; i + 1 < centroids.size(); ++i) {
+        double step = (centroids[i].weight + centroids[i + 1].weight) / 2;
+        if (index < cumulative + step) {
+            return centroids[i].mean + (centroids[i + 1].mean - centroids[i].mean) * (index - cumulative) / step;
+        }
+        cumulative += step;
+    }
+    const Centroid& last = centroids.back();
+    double tail = std::min(1.0, (index - cumulative) / (last.weight / 2));
+    return last.mean + (maxValue - last.mean) * tail;
+}
+
+void QuantileSketch::write(std::FILE* file) const {
+    compress();
+    writeValue<uint32_t>(file, static_cast<uint32_t>(centroids.size()));
+    writeValue<double>(file, centroids.empty() ? 0 : minValue);
+    writeValue<double>(file, centroids.empty() ? 0 : maxValue);
+    for (const Centroid& c : centroids) {
+        writeValue<float>(file, static_cast<float>(c.mean));
+        writeValue<uint32_t>(file, static_cast<uint32_t>(std::llround(c.weight)));
+    }
+}
+
+bool QuantileSketch::read(std::FILE* file) {
+    uint32_t size;
+    double low, high;
+    if (!readValue(file, size) || !readValue(file, low) || !readValue(file, high)) return false;
+    centroids.clear();
+    buffer.clear();
+    totalWeight = 0;
+    bufferedWeight = 0;
+    minValue = size ? low : std::numeric_limits<double>::infinity();
+    maxValue = size ? high : -std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < size; ++i) {
+        float mean;
+        uint32_t weight;
+        if (!readValue(file, mean) || !readValue(file, weight)) return false;
+        centroids.push_back(Centroid{ mean, static_cast<double>(weight) });
+        totalWeight += weight;
+    }
+    return true;
+}
+
+SketchStore::SketchStore(const std::string& path, const std::string& logPath)
+    : sketchFilePath(path), logFilePath(logPath), sketches(KindCount) {
+    load(sketchFilePath);
+}
+
+const char* SketchStore::kindName(Kind kind) {
+    switch (kind) {
+        case Focus: return "focus";
+        case Hyperfocus: return "hyperfocus";
+        case Rest: return "rest";
+        case Idle: return "idle";
+        case FocusGood: return "focus (good)";
+        case FocusBad: return "focus (bad)";
+        case FocusOkay: return "focus (okay)";
+        case KindCount: break;
+    }
+    return "";
+}
+
+bool SketchStore::add(const LogRecord& record) {
+    double minutes = record.value;
+    switch (record.event) {
+        case LogEvent::Focus:
+            sketches[Focus].add(minutes);
+            if (record.rating == Rating::Good) sketches[FocusGood].add(minutes);
+            if (record.rating == Rating::Bad) sketches[FocusBad].add(minutes);
+            if (record.rating == Rating::Okay) sketches[FocusOkay].add(minutes);
+            return true;
+        case LogEvent::Hyperfocus:
+            sketches[Hyperfocus].add(minutes);
+            return true;
+        case LogEvent::Rest:
+            sketches[Rest].add(minutes);
+            return true;
+        case LogEvent::Idle:
+            sketches[Idle].add(minutes);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SketchStore::backfill() {
+    if (sketchFilePath.empty()) return false;
+    std::error_code error;
+    if (std::filesystem::exists(sketchFilePath, error)) return false;
+    rebuild(logFilePath);
+    save();
+    return true;
+}
+
+bool SketchStore::save() const {
+    std::FILE* file = std::fopen(sketchFilePath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not save " << sketchFilePath << std::endl;
+        return false;
+    }
+    std::fwrite(sketchMagic, 1, sizeof(sketchMagic), file);
+    writeValue<uint32_t>(file, sketchVersion);
+    writeValue<uint32_t>(file, KindCount);
+    for (const QuantileSketch& sketch : sketches) {
+        sketch.write(file);
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool SketchStore::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, sketchMagic, sizeof(magic)) == 0 &&
+              readValue(file, version) && version == sketchVersion &&
+              readValue(file, count) && count == KindCount;
+    for (uint32_t i = 0; ok && i < count; ++i) {
+        ok = sketches[i].read(file);
+    }
+    std::fclose(file);
+    if (!ok) {
+        std::cerr << "Error: " << path << " is not a valid sketch file" << std::endl;
+        clear();
+    }
+    return ok;
+}
+
+void SketchStore::rebuild(const std::string& logPath) {
+    clear();
+    forEachHistoryRecord(logPath, [this](const LogRecord& record) { add(record); });
+}
+
+void SketchStore::merge(const SketchStore& other) {
+    for (int kind = 0; kind < KindCount; ++kind) {
+        sketches[kind].merge(other.sketches[kind]);
+    }
+}
+
+void SketchStore::clear() {
+    sketches.assign(KindCount, QuantileSketch());
+}
+
+namespace {
+
+const double reportQuantiles[] = { 0.10, 0.50, 0.90, 0.99 };
+
+// Compare sketch answers with exact quantiles on synthetic durations
+int runStatsBench(size_t n) {
+    std::mt19937_64 rng(42);
+    std::lognormal_distribution<double> minutes(std::log(20.0), 0.6);
+    std::vector<double> values(n);
+    for (double& v : values) v = minutes(rng);
+
+    QuantileSketch single;
+    auto start = std::chrono::steady_clock::now();
+    for (double v : values) single.add(v);
+    single.centroidCount();
+    double addNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+
+    // Same data split across 8 "users" and merged
+    std::vector<QuantileSketch> parts(8);
+    for (size_t i = 0; i < n; ++i) parts[i % parts.size()].add(values[i]);
+    QuantileSketch merged;
+    for (const QuantileSketch& part : parts) merged.merge(part);
+
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    auto rankOf = [&sorted](double value) {
+        auto low = std::lower_bound(sorted.begin(), sorted.end(), value);
+        auto high = std::upper_bound(sorted.begin(), sorted.end(), value);
+        return ((low - sorted.begin()) + (high - sorted.begin())) / 2.0 / sorted.size();
+    };
+
+    std::cout << n << " values, " << std::fixed << std::setprecision(1) << addNs << " ns/add, "
+              << single.centroidCount() << " centroids (" << single.centroidCount() * 8 + 20 << " bytes on disk)\n\n";
+    std::cout << std::left << std::setw(6) << "q" << std::right << std::setw(10) << "exact"
+              << std::setw(10) << "sketch" << std::setw(12) << "rank err" << std::setw(10) << "merged"
+              << std::setw(12) << "rank err" << "\n";
+    double worst = 0;
+    for (double q : reportQuantiles) {
+        double exact = sorted[static_cast<size_t>(q * (sorted.size() - 1))];
+        double estimate = single.quantile(q);
+        double mergedEstimate = merged.quantile(q);
+        double error = std::fabs(rankOf(estimate) - q);
+        double mergedError = std::fabs(rankOf(mergedEstimate) - q);
+        worst = std::max(worst, std::max(error, mergedError));
+        std::cout << std::left << std::setw(6) << std::setprecision(2) << q << std::right << std::setprecision(3)
+                  << std::setw(10) << exact << std::setw(10) << estimate << std::setw(11) << error * 100 << "%"
+                  << std::setw(10) << mergedEstimate << std::setw(11) << mergedError * 100 << "%\n";
+    }
+    std::cout << "\nWorst rank error " << std::setprecision(3) << worst * 100 << "%" << std::endl;
+    // Rank error above 1% means the sketch is broken, not merely imprecise
+    return worst <= 0.01 ? 0 : 2;
+}
+
+void printStore(const SketchStore& store) {
+    std::cout << std::left << std::setw(16) << "Minutes" << std::right << std::setw(8) << "n"
+              << std::setw(8) << "p10" << std::setw(8) << "p50" << std::setw(8) << "p90"
+              << std::setw(8) << "p99" << std::setw(8) << "max" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (int kind = 0; kind < SketchStore::KindCount; ++kind) {
+        const QuantileSketch& sketch = store.sketch(static_cast<SketchStore::Kind>(kind));
+        std::cout << std::left << std::setw(16) << SketchStore::kindName(static_cast<SketchStore::Kind>(kind))
+                  << std::right << std::setw(8) << static_cast<uint64_t>(sketch.count());
+        if (sketch.count() == 0) {
+            std::cout << std::setw(8) << "-" << "\n";
+            continue;
+        }
+        for (double q : reportQuantiles) std::cout << std::setw(8) << sketch.quantile(q);
+        std::cout << std::setw(8) << sketch.max() << "\n";
+    }
+}
+
+} // namespace
+
+int runStatsCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI stats [--rebuild] [--merge sketches.bin ...]\n"
+        "       ADHDPomodoro-CLI stats bench [n=1000000]";
+    bool rebuild = false;
+    std::vector<std::string> mergeFiles;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "bench") {
+            size_t n = 1000000;
+            for (int j = i + 1; j < argc; ++j) {
+                std::string option = argv[j];
+                if (option.compare(0, 2, "n=") == 0 && parseOptionValue(option.substr(2), n)) {
+                    n = std::max<size_t>(1, n);
+                } else {
+                    std::cerr << usage << std::endl;
+                    return 1;
+                }
+            }
+            return runStatsBench(n);
+        } else if (arg == "--rebuild") {
+            rebuild = true;
+        } else if (arg == "--merge") {
+            while (i + 1 < argc && argv[i + 1][0] != '-') mergeFiles.push_back(argv[++i]);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    SketchStore store;
+    if (rebuild) {
+        store.rebuild("log.txt");
+        store.save();
+    } else if (store.backfill()) {
+        std::cout << "Sketches built from log.txt\n";
+    }
+
+    for (const std::string& path : mergeFiles) {
+        SketchStore other("");
+        if (!other.load(path)) return 1;
+        store.merge(other);
+    }
+    printStore(store);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * Mergeable quantile sketch (merging t-digest).
+ *
+ * Values are kept as weighted centroids that are small near both tails and
+ * larger in the middle, so p1/p99 stay accurate while the whole sketch fits
+ * in about compression centroids. Two sketches merge into one that answers
+ * as if it had seen both inputs.
+ */
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double compression = 100);
+
+    void add(double value, double weight = 1);
+    void merge(const QuantileSketch& other);
+
+    // Estimated value at quantile q in [0, 1]; NaN when empty
+    double quantile(double q) const;
+    double count() const { return totalWeight + bufferedWeight; }
+    double min() const { return minValue; }
+    double max() const { return maxValue; }
+    size_t centroidCount() const;
+
+    void write(std::FILE* file) const;
+    bool read(std::FILE* file);
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    double compression;
+    // Merged centroids sorted by mean, plus values not merged yet; compressed lazily
+    mutable std::vector<Centroid> centroids;
+    mutable std::vector<Centroid> buffer;
+    mutable double totalWeight;
+    mutable double bufferedWeight;
+    double minValue;
+    double maxValue;
+
+    void compress() const;
+};
+
+/**
+ * Duration distributions of the session log in minutes: one sketch per
+ * state (focus, hyperfocus, rest, idle) and per focus rating, persisted
+ * together in sketches.bin (a few KB regardless of history length).
+ */
+class SketchStore {
+public:
+    enum Kind {
+        Focus,
+        Hyperfocus,
+        Rest,
+        Idle,
+        FocusGood,
+        FocusBad,
+        FocusOkay,
+        KindCount
+    };
+
+    explicit SketchStore(const std::string& path = "sketches.bin", const std::string& logPath = "log.txt");
+
+    // Fold a log record into the sketches; returns false if it carries no duration
+    bool add(const LogRecord& record);
+    // Build and save the sketches from the whole history if the file is missing, so
+    // existing logs are covered from the start; returns true if it rebuilt
+    bool backfill();
+    bool save() const;
+    bool load(const std::string& path);
+    void rebuild(const std::string& logPath);
+    void merge(const SketchStore& other);
+    void clear();
+
+    const QuantileSketch& sketch(Kind kind) const { return sketches[kind]; }
+    static const char* kindName(Kind kind);
+
+private:
+    std::string sketchFilePath;
+    std::string logFilePath;
+    std::vector<QuantileSketch> sketches;
+};
+
+// "ADHDPomodoro-CLI stats [--rebuild] [--merge FILE...] | stats bench [n=..]"
+int runStatsCommand(int argc, char* argv[]);
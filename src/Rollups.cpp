@@ -0,0 +1,450 @@
+#include "Rollups.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include "LogArchive.h"
+
+namespace {
+
+struct ResolutionInfo {
+    const char* name;
+    int64_t seconds;
+    int64_t offset;     // shift so that buckets start on a sensible boundary
+    uint32_t slots;
+};
+
+const ResolutionInfo resolutions[] = {
+    { "minute", 60, 0, 14 * 24 * 60 },
+    { "hour", 3600, 0, 2 * 366 * 24 },
+    { "day", 86400, 0, 50 * 366 },
+    { "week", 7 * 86400, 3 * 86400, 50 * 53 },   // 1970-01-01 was a Thursday; weeks start on Monday
+};
+
+struct RollupHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t resolutionSeconds;
+    uint32_t slotCount;
+};
+
+const char rollupMagic[4] = { 'P', 'R', 'L', 'P' };
+const uint32_t rollupVersion = 1;
+
+const ResolutionInfo& info(RollupResolution resolution) {
+    return resolutions[static_cast<int>(resolution)];
+}
+
+uint32_t bucketOf(RollupResolution resolution, int64_t time) {
+    const ResolutionInfo& r = info(resolution);
+    return static_cast<uint32_t>((time + r.offset) / r.seconds);
+}
+
+std::streamoff slotOffset(RollupResolution resolution, uint32_t bucket) {
+    return static_cast<std::streamoff>(sizeof(RollupHeader)) +
+           static_cast<std::streamoff>(bucket % info(resolution).slots) * static_cast<std::streamoff>(sizeof(RollupSlot));
+}
+
+uint32_t* secondsField(RollupSlot& slot, LogEvent event) {
+    switch (event) {
+        case LogEvent::Focus: return &slot.focusSeconds;
+        case LogEvent::Hyperfocus: return &slot.hyperfocusSeconds;
+        case LogEvent::Rest: return &slot.restSeconds;
+        case LogEvent::Idle: return &slot.idleSeconds;
+        default: return nullptr;
+    }
+}
+
+// Spread a record's duration over the buckets it covers; slotAt returns nullptr
+// for buckets that have already been overwritten by a newer lap of the ring
+template <typename SlotAt>
+void applyRecord(RollupResolution resolution, const LogRecord& record, SlotAt slotAt) {
+    RollupSlot probe;
+    if (!secondsField(probe, record.event) || record.timestamp <= 0) return;
+
+    const int64_t end = record.timestamp;
+    const int64_t start = std::max<int64_t>(0, end - static_cast<int64_t>(record.value) * 60);
+    for (uint32_t bucket = bucketOf(resolution, start); start < end; ++bucket) {
+        int64_t bucketBegin = RollupStore::bucketStart(resolution, bucket);
+        if (bucketBegin >= end) break;
+        int64_t overlap = std::min(end, bucketBegin + info(resolution).seconds) - std::max(start, bucketBegin);
+        if (RollupSlot* slot = slotAt(bucket)) {
+            *secondsField(*slot, record.event) += static_cast<uint32_t>(overlap);
+        }
+    }
+    if (record.event == LogEvent::Focus || record.event == LogEvent::Hyperfocus) {
+        if (RollupSlot* slot = slotAt(bucketOf(resolution, start < end ? end - 1 : end))) {
+            slot->sessions++;
+        }
+    }
+}
+
+// Claim a ring slot for a bucket, clearing data from an older lap
+RollupSlot* claimSlot(RollupSlot& slot, uint32_t bucket) {
+    if (slot.bucket == bucket) return &slot;
+    if (slot.bucket > bucket) return nullptr;
+    slot = RollupSlot();
+    slot.bucket = bucket;
+    return &slot;
+}
+
+} // namespace
+
+RollupStore::RollupStore(const std::string& directory, const std::string& logPath)
+    : directory(directory), logFilePath(logPath) {}
+
+std::string RollupStore::filePath(RollupResolution resolution) const {
+    return directory + "/rollup-" + info(resolution).name + ".bin";
+}
+
+const char* RollupStore::resolutionName(RollupResolution resolution) {
+    return info(resolution).name;
+}
+
+int64_t RollupStore::bucketStart(RollupResolution resolution, uint32_t bucket) {
+    const ResolutionInfo& r = info(resolution);
+    return static_cast<int64_t>(bucket) * r.seconds - r.offset;
+}
+
+RollupResolution RollupStore::pickResolution(int64_t from, int64_t to, size_t maxPoints) {
+    for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+        RollupResolution resolution = static_cast<RollupResolution>(i);
+        const ResolutionInfo& r = info(resolution);
+        uint64_t buckets = static_cast<uint64_t>((to - from + r.seconds - 1) / r.seconds);
+        if (buckets <= maxPoints && buckets <= r.slots) return resolution;
+    }
+    return RollupResolution::Week;
+}
+
+bool RollupStore::createFile(RollupResolution resolution, const std::vector<RollupSlot>* slots) const {
+    std::ofstream file(filePath(resolution), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create rollup file " << filePath(resolution) << std::endl;
+        return false;
+    }
+    RollupHeader header;
+    std::memcpy(header.magic, rollupMagic, sizeof(rollupMagic));
+    header.version = rollupVersion;
+    header.resolutionSeconds = static_cast<uint32_t>(info(resolution).seconds);
+    header.slotCount = info(resolution).slots;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<RollupSlot> empty;
+    if (!slots) {
+        empty.resize(header.slotCount);
+        slots = &empty;
+    }
+    file.write(reinterpret_cast<const char*>(slots->data()),
+               static_cast<std::streamsize>(slots->size() * sizeof(RollupSlot)));
+    return static_cast<bool>(file);
+}
+
+bool RollupStore::backfill() {
+    for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+        std::error_code error;
+        if (!std::filesystem::exists(filePath(static_cast<RollupResolution>(i)), error)) {
+            rebuild(logFilePath);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RollupStore::add(const LogRecord& record) {
+    RollupSlot probe;
+    if (!secondsField(probe, record.event)) return;
+    // The rebuild reads the record from the log
+    if (backfill()) return;
+
+    for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+        RollupResolution resolution = static_cast<RollupResolution>(i);
+        std::fstream file(filePath(resolution), std::ios::binary | std::ios::in | std::ios::out);
+        if (!file.is_open()) continue;
+
+        // Read-modify-write only the slots this record touches
+        std::map<uint32_t, RollupSlot> touched;
+        applyRecord(resolution, record, [&](uint32_t bucket) -> RollupSlot* {
+            auto it = touched.find(bucket);
+            if (it == touched.end()) {
+                RollupSlot slot;
+                file.seekg(slotOffset(resolution, bucket));
+                file.read(reinterpret_cast<char*>(&slot), sizeof(slot));
+                it = touched.emplace(bucket, slot).first;
+            }
+            return claimSlot(it->second, bucket);
+        });
+        file.clear();
+        for (const auto& entry : touched) {
+            if (entry.second.bucket != entry.first) continue;
+            file.seekp(slotOffset(resolution, entry.first));
+            file.write(reinterpret_cast<const char*>(&entry.second), sizeof(RollupSlot));
+        }
+    }
+}
+
+void RollupStore::rebuild(const std::vector<LogRecord>& records) {
+    for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+        RollupResolution resolution = static_cast<RollupResolution>(i);
+        std::vector<RollupSlot> slots(info(resolution).slots);
+        for (const LogRecord& record : records) {
+            applyRecord(resolution, record, [&](uint32_t bucket) {
+                return claimSlot(slots[bucket % slots.size()], bucket);
+            });
+        }
+        createFile(resolution, &slots);
+    }
+}
+
+void RollupStore::rebuild(const std::string& logPath) {
+    std::vector<std::vector<RollupSlot>> slots;
+    for (const ResolutionInfo& r : resolutions) {
+        slots.emplace_back(r.slots);
+    }
+    forEachHistoryRecord(logPath, [&](const LogRecord& record) {
+        for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+            std::vector<RollupSlot>& ring = slots[i];
+            applyRecord(static_cast<RollupResolution>(i), record, [&](uint32_t bucket) {
+                return claimSlot(ring[bucket % ring.size()], bucket);
+            });
+        }
+    });
+    for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+        createFile(static_cast<RollupResolution>(i), &slots[i]);
+    }
+}
+
+std::vector<RollupSlot> RollupStore::range(RollupResolution resolution, int64_t from, int64_t to) const {
+    std::vector<RollupSlot> result;
+    if (to <= from) return result;
+
+    const uint32_t slotCount = info(resolution).slots;
+    const uint32_t first = bucketOf(resolution, std::max<int64_t>(0, from));
+    const uint32_t last = bucketOf(resolution, std::max<int64_t>(0, to - 1));
+    result.resize(static_cast<size_t>(last - first) + 1);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i].bucket = first + static_cast<uint32_t>(i);
+    }
+
+    std::ifstream file(filePath(resolution), std::ios::binary);
+    RollupHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, rollupMagic, sizeof(rollupMagic)) != 0 || header.slotCount != slotCount) {
+        return result;
+    }
+
+    // Only the newest slotCount buckets can still be in the ring
+    const uint32_t readFirst = last - first + 1 > slotCount ? last - slotCount + 1 : first;
+    RollupSlot* out = result.data() + (readFirst - first);
+    uint32_t remaining = last - readFirst + 1;
+    uint32_t slot = readFirst % slotCount;
+    while (remaining > 0) {
+        uint32_t chunk = std::min(remaining, slotCount - slot);
+        file.seekg(slotOffset(resolution, slot));
+        file.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(chunk * sizeof(RollupSlot)));
+        out += chunk;
+        remaining -= chunk;
+        slot = 0;
+    }
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        uint32_t bucket = first + static_cast<uint32_t>(i);
+        if (result[i].bucket != bucket) {
+            result[i] = RollupSlot();
+            result[i].bucket = bucket;
+        }
+    }
+    return result;
+}
+
+namespace {
+
+bool parseResolution(const std::string& text, RollupResolution& out) {
+    for (int i = 0; i < static_cast<int>(RollupResolution::Count); ++i) {
+        if (text == resolutions[i].name) {
+            out = static_cast<RollupResolution>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Ten (or more) years of plausible sessions: a few focus blocks per day with rest in between
+std::vector<LogRecord> simulateHistory(int years, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> sessionsPerDay(2, 8);
+    std::uniform_int_distribution<int> focusMinutes(10, 60);
+    std::uniform_int_distribution<int> gapMinutes(0, 90);
+    std::uniform_int_distribution<int> rating(1, 3);
+    std::bernoulli_distribution hyperfocus(0.1);
+
+    std::vector<LogRecord> records;
+    const int64_t end = localNow();
+    const int64_t begin = end - static_cast<int64_t>(years) * 365 * 86400;
+    for (int64_t day = begin - begin % 86400; day < end; day += 86400) {
+        int64_t time = day + 8 * 3600;
+        int sessions = sessionsPerDay(rng);
+        for (int s = 0; s < sessions; ++s) {
+            LogRecord record;
+            int minutes = focusMinutes(rng);
+            time += minutes * 60;
+            record.timestamp = time;
+            if (hyperfocus(rng)) {
+                record.event = LogEvent::Hyperfocus;
+                record.value = static_cast<uint32_t>(minutes * 3);
+                time += minutes * 2 * 60;
+                record.timestamp = time;
+            } else {
+                record.event = LogEvent::Focus;
+                record.value = static_cast<uint32_t>(minutes);
+                record.rating = static_cast<Rating>(rating(rng));
+            }
+            records.push_back(record);
+
+            time += 5 * 60;
+            records.push_back(LogRecord{ time, LogEvent::Rest, Rating::None, 5, 0 });
+            int idle = gapMinutes(rng);
+            time += idle * 60;
+            records.push_back(LogRecord{ time, LogEvent::Idle, Rating::None, static_cast<uint32_t>(idle), 0 });
+        }
+    }
+    return records;
+}
+
+int runRollupBench(int years, int queries) {
+    std::error_code error;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(error) / "pomodoro-rollup-bench";
+    std::filesystem::create_directories(dir, error);
+
+    std::vector<LogRecord> records = simulateHistory(years, 42);
+    RollupStore store(dir.string());
+
+    auto buildStart = std::chrono::steady_clock::now();
+    store.rebuild(records);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    std::cout << "Simulated " << years << " years: " << records.size() << " records, rollups built in "
+              << std::fixed << std::setprecision(1) << buildMs << " ms\n\n";
+
+    const int64_t end = records.back().timestamp;
+    const int64_t begin = records.front().timestamp;
+    std::mt19937 rng(7);
+
+    struct Case { const char* name; int64_t minSpan; int64_t maxSpan; bool recent; };
+    const Case cases[] = {
+        { "last day", 86400, 86400, true },
+        { "week", 7 * 86400, 7 * 86400, false },
+        { "month", 30 * 86400, 31 * 86400, false },
+        { "year", 365 * 86400, 366 * 86400, false },
+        { "any span", 3600, end - begin, false },
+    };
+
+    std::cout << std::left << std::setw(10) << "range" << std::setw(8) << "res" << std::right
+              << std::setw(10) << "points" << std::setw(12) << "mean us" << std::setw(12) << "p99 us" << "\n";
+    for (const Case& c : cases) {
+        std::vector<double> micros;
+        size_t points = 0;
+        RollupResolution resolution = RollupResolution::Minute;
+        for (int q = 0; q < queries; ++q) {
+            int64_t span = std::uniform_int_distribution<int64_t>(c.minSpan, c.maxSpan)(rng);
+            int64_t from = c.recent
+                ? end - span
+                : std::uniform_int_distribution<int64_t>(begin, std::max(begin, end - span))(rng);
+            resolution = RollupStore::pickResolution(from, from + span, 500);
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<RollupSlot> slots = store.range(resolution, from, from + span);
+            micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            points += slots.size();
+        }
+        std::sort(micros.begin(), micros.end());
+        double sum = 0;
+        for (double m : micros) sum += m;
+        std::cout << std::left << std::setw(10) << c.name << std::setw(8) << RollupStore::resolutionName(resolution)
+                  << std::right << std::setw(10) << points / micros.size()
+                  << std::setw(12) << std::setprecision(1) << sum / micros.size()
+                  << std::setw(12) << micros[micros.size() * 99 / 100] << "\n";
+    }
+
+    std::filesystem::remove_all(dir, error);
+    return 0;
+}
+
+} // namespace
+
+int runRollupCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI rollup rebuild\n"
+        "       ADHDPomodoro-CLI rollup show [from=YYYY-MM-DD] [to=YYYY-MM-DD] [points=N] [res=minute|hour|day|week]\n"
+        "       ADHDPomodoro-CLI rollup bench [years=10] [queries=1000]";
+    std::string action = argc > 2 ? argv[2] : "";
+
+    int64_t to = localNow();
+    int64_t from = to - 30 * 86400;
+    size_t points = 60;
+    int years = 10;
+    int queries = 1000;
+    bool fixedResolution = false;
+    RollupResolution resolution = RollupResolution::Day;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        int64_t epoch;
+        if ((key == "from" || key == "to") && parseEpoch(value.data(), value.size(), epoch)) {
+            (key == "from" ? from : to) = epoch;
+        } else if (key == "points" && parseOptionValue(value, points) && points > 0) {
+        } else if (key == "res" && parseResolution(value, resolution)) {
+            fixedResolution = true;
+        } else if (key == "years" && parseOptionValue(value, years)) {
+            years = std::max(1, years);
+        } else if (key == "queries" && parseOptionValue(value, queries)) {
+            queries = std::max(1, queries);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    RollupStore store;
+    if (action == "rebuild") {
+        auto start = std::chrono::steady_clock::now();
+        store.rebuild("log.txt");
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Rollups rebuilt from log.txt in " << ms << " ms" << std::endl;
+        return 0;
+    }
+    if (action == "bench") {
+        return runRollupBench(years, queries);
+    }
+    if (action != "show") {
+        std::cerr << usage << std::endl;
+        return 1;
+    }
+    if (store.backfill()) {
+        std::cout << "Rollups built from log.txt\n";
+    }
+
+    if (!fixedResolution) {
+        resolution = RollupStore::pickResolution(from, to, points);
+    }
+    std::cout << "Resolution: " << RollupStore::resolutionName(resolution) << "\n";
+    std::cout << std::left << std::setw(22) << "Bucket" << std::right << std::setw(8) << "Focus"
+              << std::setw(8) << "Hyper" << std::setw(8) << "Rest" << std::setw(8) << "Idle"
+              << std::setw(10) << "Sessions" << "\n";
+    for (const RollupSlot& slot : store.range(resolution, from, to)) {
+        if (slot.focusSeconds + slot.hyperfocusSeconds + slot.restSeconds + slot.idleSeconds + slot.sessions == 0) {
+            continue;
+        }
+        std::cout << std::left << std::setw(22) << formatEpoch(RollupStore::bucketStart(resolution, slot.bucket))
+                  << std::right << std::setw(8) << slot.focusSeconds / 60 << std::setw(8) << slot.hyperfocusSeconds / 60
+                  << std::setw(8) << slot.restSeconds / 60 << std::setw(8) << slot.idleSeconds / 60
+                  << std::setw(10) << slot.sessions << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * Time-series rollups of logged focus/rest time.
+ *
+ * Each resolution is a fixed-size binary ring file (rollup-<name>.bin) with
+ * one slot per time bucket, addressed directly as bucket % slotCount, so any
+ * range is fetched with at most two contiguous reads:
+ *   minute  14 days    hour  2 years    day  50 years    week  50 years
+ * Every slot records which bucket it holds; slots left over from an older lap
+ * of the ring read as empty.
+ */
+
+enum class RollupResolution {
+    Minute,
+    Hour,
+    Day,
+    Week,
+    Count
+};
+
+struct RollupSlot {
+    uint32_t bucket = 0;
+    uint32_t focusSeconds = 0;
+    uint32_t hyperfocusSeconds = 0;
+    uint32_t restSeconds = 0;
+    uint32_t idleSeconds = 0;
+    uint32_t sessions = 0;          // Focus/Hyperfocus blocks ending in this bucket
+};
+
+class RollupStore {
+public:
+    explicit RollupStore(const std::string& directory = ".", const std::string& logPath = "log.txt");
+
+    // Fold one record (already written to the log) into every resolution, touching only
+    // the affected slots
+    void add(const LogRecord& record);
+    // Build the files from the whole history if any is missing, so existing logs are
+    // covered from the start; returns true if it rebuilt
+    bool backfill();
+    // Recreate all files from a log (built in memory, written once per file)
+    void rebuild(const std::string& logPath);
+    void rebuild(const std::vector<LogRecord>& records);
+
+    // One slot per bucket overlapping [from, to); buckets outside retention are empty
+    std::vector<RollupSlot> range(RollupResolution resolution, int64_t from, int64_t to) const;
+
+    // Finest resolution that covers [from, to) within retention using at most maxPoints buckets
+    static RollupResolution pickResolution(int64_t from, int64_t to, size_t maxPoints);
+    static int64_t bucketStart(RollupResolution resolution, uint32_t bucket);
+    static const char* resolutionName(RollupResolution resolution);
+
+private:
+    std::string directory;
+    std::string logFilePath;
+
+    std::string filePath(RollupResolution resolution) const;
+    bool createFile(RollupResolution resolution, const std::vector<RollupSlot>* slots) const;
+};
+
+// "ADHDPomodoro-CLI rollup rebuild | show [from=..] [to=..] [points=N] | bench [years]"
+int runRollupCommand(int argc, char* argv[]);
@@ -0,0 +1,25 @@
+#include "SessionHistory.h"
+
+void SessionHistory::attach(SessionLogger& logger) {
+    tagStats.backfill();
+    rollups.backfill();
+    sketches.backfill();
+    quality.backfill();
+    logger.addListener([this](const LogRecord& record) {
+        // A backfill already read this record from the log
+        if ((record.event == LogEvent::Focus || record.event == LogEvent::Hyperfocus) && !tagStats.backfill()) {
+            tagStats.add(record);
+            tagStats.save();
+        }
+        if (updateIndexOnLog) {
+            index.update();
+        }
+        rollups.add(record);
+        if (!sketches.backfill() && sketches.add(record)) {
+            sketches.save();
+        }
+        if (!quality.backfill() && quality.add(record)) {
+            quality.save();
+        }
+    });
+}
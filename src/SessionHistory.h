@@ -0,0 +1,26 @@
+#pragma once
+#include "SessionLog.h"
+#include "TagTable.h"
+#include "SessionIndex.h"
+#include "Rollups.h"
+#include "QuantileSketch.h"
+#include "QualityModel.h"
+
+/**
+ * Everything derived from the session log that is kept up to date as
+ * records are written: per-tag aggregates, the search index, rollups,
+ * duration sketches and the session quality model.
+ */
+struct SessionHistory {
+    TagTable tags;
+    TagStats tagStats;
+    SessionIndex index;
+    RollupStore rollups;
+    SketchStore sketches;
+    QualityModel quality;
+    // Off when another thread keeps the index current (the GUI timeline's worker)
+    bool updateIndexOnLog = true;
+
+    // Register listeners so every logged record updates the derived data
+    void attach(SessionLogger& logger);
+};
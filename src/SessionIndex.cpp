@@ -0,0 +1,772 @@
+#include "SessionIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include "LogArchive.h"
+#include "TagTable.h"
+
+namespace {
+
+void appendVarint(std::string& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void appendRaw(std::string& out, const void* data, size_t size) {
+    out.append(static_cast<const char*>(data), size);
+}
+
+void appendToFile(const std::string& path, const std::string& data) {
+    if (data.empty()) return;
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not write index file " << path << std::endl;
+        return;
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+template <typename T>
+void appendValue(std::string& out, T value) {
+    appendRaw(out, &value, sizeof(value));
+}
+
+template <typename T>
+T readValue(const char* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(value));
+    return value;
+}
+
+const size_t docSize = 48;          // see encodeSession
+const size_t blockSize = 18;        // timestamp, value, tag, event, rating
+const size_t skipEntrySize = 12;    // first id, byte offset
+const uint32_t postingsPerBlock = 128;
+const uint32_t endOfList = UINT32_MAX;
+
+void encodeSession(std::string& out, const SessionIndex::Session& session) {
+    appendValue(out, session.start);
+    appendValue(out, session.end);
+    appendValue(out, session.focusMinutes);
+    appendValue(out, session.hyperfocusMinutes);
+    appendValue(out, session.blocks);
+    appendValue(out, session.good);
+    appendValue(out, session.bad);
+    appendValue(out, session.okay);
+    appendValue(out, session.tagId);
+    appendValue(out, static_cast<uint8_t>(session.terminal));
+    out.append(docSize - 45, '\0');
+}
+
+void decodeSession(const char* data, SessionIndex::Session& session) {
+    session.start = readValue<int64_t>(data, 0);
+    session.end = readValue<int64_t>(data, 8);
+    session.focusMinutes = readValue<uint32_t>(data, 16);
+    session.hyperfocusMinutes = readValue<uint32_t>(data, 20);
+    session.blocks = readValue<uint32_t>(data, 24);
+    session.good = readValue<uint32_t>(data, 28);
+    session.bad = readValue<uint32_t>(data, 32);
+    session.okay = readValue<uint32_t>(data, 36);
+    session.tagId = readValue<uint32_t>(data, 40);
+    session.terminal = static_cast<LogEvent>(readValue<uint8_t>(data, 44));
+}
+
+// Positioned reads of a posting list, one block of postings at a time
+class PostingCursor {
+public:
+    PostingCursor(const std::string& postPath, const std::string& skipPath, uint32_t count, uint64_t bytes)
+        : postFile(std::fopen(postPath.c_str(), "rb")), skipFile(std::fopen(skipPath.c_str(), "rb")),
+          blockCount((count + postingsPerBlock - 1) / postingsPerBlock), postBytes(bytes), loaded(UINT32_MAX),
+          position(0) {
+        if (!postFile || !skipFile) blockCount = 0;
+    }
+    ~PostingCursor() {
+        if (postFile) std::fclose(postFile);
+        if (skipFile) std::fclose(skipFile);
+    }
+
+    PostingCursor(const PostingCursor&) = delete;
+    PostingCursor& operator=(const PostingCursor&) = delete;
+
+    // First id >= target from the current position on
+    uint32_t seek(uint32_t target) {
+        while (true) {
+            if (position < docs.size() && docs.back() >= target) {
+                position = static_cast<size_t>(
+                    std::lower_bound(docs.begin() + static_cast<std::ptrdiff_t>(position), docs.end(), target) - docs.begin());
+                return docs[position];
+            }
+            // The last block that starts at or before the target, after the loaded one
+            uint32_t lo = loaded == UINT32_MAX ? 0 : loaded + 1;
+            if (lo >= blockCount) {
+                position = docs.size();
+                return endOfList;
+            }
+            uint32_t hi = blockCount - 1;
+            while (lo < hi) {
+                uint32_t mid = lo + (hi - lo + 1) / 2;
+                uint32_t first;
+                uint64_t offset;
+                if (!readSkip(mid, first, offset)) return fail();
+                if (first <= target) lo = mid;
+                else hi = mid - 1;
+            }
+            if (!loadBlock(lo)) return fail();
+        }
+    }
+
+private:
+    std::FILE* postFile;
+    std::FILE* skipFile;
+    uint32_t blockCount;
+    uint64_t postBytes;
+    uint32_t loaded;
+    std::vector<uint32_t> docs;
+    size_t position;
+    std::string bytes;
+
+    uint32_t fail() {
+        blockCount = 0;
+        docs.clear();
+        position = 0;
+        return endOfList;
+    }
+
+    bool readSkip(uint32_t block, uint32_t& first, uint64_t& offset) {
+        char entry[skipEntrySize];
+        if (!seekFile(skipFile, static_cast<uint64_t>(block) * skipEntrySize) ||
+            std::fread(entry, sizeof(entry), 1, skipFile) != 1) {
+            return false;
+        }
+        first = readValue<uint32_t>(entry, 0);
+        offset = readValue<uint64_t>(entry, 4);
+        return true;
+    }
+
+    bool loadBlock(uint32_t block) {
+        uint32_t first, next;
+        uint64_t offset, end = postBytes;
+        if (!readSkip(block, first, offset)) return false;
+        if (block + 1 < blockCount && !readSkip(block + 1, next, end)) return false;
+        if (end < offset) return false;
+
+        bytes.resize(static_cast<size_t>(end - offset));
+        if (!seekFile(postFile, offset) ||
+            (!bytes.empty() && std::fread(&bytes[0], 1, bytes.size(), postFile) != bytes.size())) {
+            return false;
+        }
+
+        // The first delta is relative to the previous block; the skip entry has the id itself
+        docs.clear();
+        uint32_t doc = first;
+        uint32_t value = 0;
+        int shift = 0;
+        for (char c : bytes) {
+            uint8_t byte = static_cast<uint8_t>(c);
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (byte & 0x80) {
+                shift += 7;
+                continue;
+            }
+            if (!docs.empty()) doc += value;
+            docs.push_back(doc);
+            value = 0;
+            shift = 0;
+        }
+        loaded = block;
+        position = 0;
+        return !docs.empty();
+    }
+};
+
+// Union of the posting lists of one filter (tag=a,b)
+class AnyCursor {
+public:
+    void add(std::unique_ptr<PostingCursor> cursor, uint32_t count) {
+        cursors.push_back(std::move(cursor));
+        total += count;
+    }
+    uint64_t cost() const { return total; }
+
+    uint32_t seek(uint32_t target) {
+        uint32_t doc = endOfList;
+        for (auto& cursor : cursors) {
+            doc = std::min(doc, cursor->seek(target));
+        }
+        return doc;
+    }
+
+private:
+    std::vector<std::unique_ptr<PostingCursor>> cursors;
+    uint64_t total = 0;
+};
+
+} // namespace
+
+std::string tagTerm(uint32_t tagId) {
+    return "tag-" + std::to_string(tagId);
+}
+
+std::string ratingTerm(Rating rating) {
+    std::string term = std::string("rating-") + ratingName(rating);
+    std::transform(term.begin(), term.end(), term.begin(), ::tolower);
+    return term;
+}
+
+std::string stateTerm(LogEvent event) {
+    return std::string("state-") + eventName(event);
+}
+
+SessionIndex::SessionIndex(const std::string& logPath, const std::string& indexPath)
+    : logFilePath(logPath), indexDir(indexPath), sealedSequence(0), liveRecords(0), logOffset(0), docCount(0),
+      blockTotal(0), stale(false), open(false), docsReader(nullptr), blocksReader(nullptr) {
+    loadMeta();
+}
+
+SessionIndex::~SessionIndex() {
+    closeReaders();
+}
+
+void SessionIndex::closeReaders() {
+    if (docsReader) std::fclose(docsReader);
+    if (blocksReader) std::fclose(blocksReader);
+    docsReader = nullptr;
+    blocksReader = nullptr;
+}
+
+std::string SessionIndex::termPath(const std::string& term, const char* extension) const {
+    return indexDir + "/" + term + extension;
+}
+
+void SessionIndex::loadMeta() {
+    std::ifstream metaFile(indexDir + "/meta.txt");
+    if (!metaFile.is_open()) {
+        return;
+    }
+    std::string version;
+    if (!(metaFile >> version) || version != "v3") {
+        stale = true;
+        return;
+    }
+    metaFile >> sealedSequence >> liveRecords >> logOffset >> docCount >> blockTotal;
+    std::string key;
+    while (metaFile >> key) {
+        if (key == "open") {
+            Session& session = current.session;
+            int terminal;
+            size_t tagCount;
+            metaFile >> session.start >> session.end >> session.focusMinutes >> session.hyperfocusMinutes >>
+                session.blocks >> session.good >> session.bad >> session.okay >> session.tagId >> terminal >> tagCount;
+            session.terminal = static_cast<LogEvent>(terminal);
+            current.tags.resize(tagCount);
+            for (uint32_t& tag : current.tags) metaFile >> tag;
+            open = true;
+        } else {
+            TermState& term = terms[key];
+            metaFile >> term.last >> term.count >> term.bytes;
+        }
+    }
+
+    std::ifstream daysFile(indexDir + "/days.bin", std::ios::binary);
+    int32_t day;
+    uint32_t first;
+    while (daysFile.read(reinterpret_cast<char*>(&day), sizeof(day)) &&
+           daysFile.read(reinterpret_cast<char*>(&first), sizeof(first))) {
+        days.emplace_back(day, first);
+    }
+}
+
+void SessionIndex::saveMeta() const {
+    std::ofstream metaFile(indexDir + "/meta.txt");
+    if (!metaFile.is_open()) {
+        std::cerr << "Error: Could not save index metadata" << std::endl;
+        return;
+    }
+    metaFile << "v3\n" << sealedSequence << " " << liveRecords << " " << logOffset << " " << docCount << " "
+             << blockTotal << "\n";
+    if (open) {
+        const Session& session = current.session;
+        metaFile << "open " << session.start << " " << session.end << " " << session.focusMinutes << " "
+                 << session.hyperfocusMinutes << " " << session.blocks << " " << session.good << " " << session.bad
+                 << " " << session.okay << " " << session.tagId << " " << static_cast<int>(session.terminal) << " "
+                 << current.tags.size();
+        for (uint32_t tag : current.tags) metaFile << " " << tag;
+        metaFile << "\n";
+    }
+    for (const auto& entry : terms) {
+        metaFile << entry.first << " " << entry.second.last << " " << entry.second.count << " " << entry.second.bytes
+                 << "\n";
+    }
+}
+
+void SessionIndex::addPosting(const std::string& term, uint32_t doc) {
+    TermState& state = terms[term];
+    std::string& out = pendingPostings[term];
+    if (state.count % postingsPerBlock == 0) {
+        std::string& skip = pendingSkips[term];
+        appendValue(skip, doc);
+        appendValue(skip, state.bytes);
+    }
+    size_t before = out.size();
+    appendVarint(out, static_cast<uint32_t>(doc - state.last));
+    state.bytes += out.size() - before;
+    state.count++;
+    state.last = doc;
+}
+
+void SessionIndex::add(const LogRecord& record) {
+    if (record.event == LogEvent::SessionStarted && open) {
+        closeSession();
+    }
+    if (!open) {
+        // Finishing or quitting outside a session (e.g. quit after finishing) starts nothing
+        if (record.event == LogEvent::SessionFinished || record.event == LogEvent::Quit) return;
+        current = OpenSession();
+        current.session.start = record.timestamp;
+        open = true;
+    }
+
+    Session& session = current.session;
+    session.end = record.timestamp;
+    if (record.tagId != 0 && std::find(current.tags.begin(), current.tags.end(), record.tagId) == current.tags.end()) {
+        if (current.tags.empty()) session.tagId = record.tagId;
+        current.tags.push_back(record.tagId);
+    }
+
+    switch (record.event) {
+        case LogEvent::Focus:
+        case LogEvent::Hyperfocus:
+            (record.event == LogEvent::Focus ? session.focusMinutes : session.hyperfocusMinutes) += record.value;
+            session.blocks++;
+            if (record.rating == Rating::Good) session.good++;
+            if (record.rating == Rating::Bad) session.bad++;
+            if (record.rating == Rating::Okay) session.okay++;
+            session.terminal = record.event;
+
+            blockTotal++;
+            appendValue(pendingBlocks, record.timestamp);
+            appendValue(pendingBlocks, record.value);
+            appendValue(pendingBlocks, record.tagId);
+            appendValue(pendingBlocks, static_cast<uint8_t>(record.event));
+            appendValue(pendingBlocks, static_cast<uint8_t>(record.rating));
+            break;
+        case LogEvent::Rest:
+        case LogEvent::Idle:
+            session.terminal = record.event;
+            break;
+        case LogEvent::SessionFinished:
+        case LogEvent::Quit:
+            if (session.terminal == LogEvent::SessionStarted) session.terminal = record.event;
+            closeSession();
+            break;
+        default:
+            break;
+    }
+}
+
+void SessionIndex::closeSession() {
+    const Session& session = current.session;
+    uint32_t doc = docCount++;
+    encodeSession(pendingDocs, session);
+
+    int32_t day = epochDay(session.start);
+    if (days.empty() || day > days.back().first) {
+        days.emplace_back(day, doc);
+        appendValue(pendingDays, day);
+        appendValue(pendingDays, doc);
+    }
+
+    addPosting(stateTerm(session.terminal), doc);
+    if (session.good > 0) addPosting(ratingTerm(Rating::Good), doc);
+    if (session.bad > 0) addPosting(ratingTerm(Rating::Bad), doc);
+    if (session.okay > 0) addPosting(ratingTerm(Rating::Okay), doc);
+    for (uint32_t tag : current.tags) {
+        addPosting(tagTerm(tag), doc);
+    }
+    open = false;
+    current = OpenSession();
+}
+
+void SessionIndex::flush() {
+    std::error_code error;
+    std::filesystem::create_directories(indexDir, error);
+
+    for (const auto& entry : pendingPostings) {
+        appendToFile(termPath(entry.first, ".post"), entry.second);
+    }
+    for (const auto& entry : pendingSkips) {
+        appendToFile(termPath(entry.first, ".skip"), entry.second);
+    }
+    appendToFile(indexDir + "/docs.bin", pendingDocs);
+    appendToFile(indexDir + "/blocks.bin", pendingBlocks);
+    appendToFile(indexDir + "/days.bin", pendingDays);
+    pendingPostings.clear();
+    pendingSkips.clear();
+    pendingDocs.clear();
+    pendingBlocks.clear();
+    pendingDays.clear();
+    saveMeta();
+}
+
+void SessionIndex::update() {
+    if (stale) {
+        rebuild();
+        return;
+    }
+
+    // Segments sealed since the last update. The first of them was the live log then,
+    // and its first liveRecords records are indexed already.
+    std::vector<LogSegment> segments = listSegments(logFilePath);
+    if (sealedSequence > 0 && (segments.empty() || segments.back().sequence < sealedSequence)) {
+        rebuild();
+        return;
+    }
+    bool sealed = false;
+    for (const LogSegment& segment : segments) {
+        if (segment.sequence <= sealedSequence) continue;
+        uint64_t skip = sealed ? 0 : liveRecords;
+        forEachSegmentRecord(logFilePath, segment, [this, &skip](const LogRecord& record) {
+            if (skip > 0) {
+                skip--;
+                return;
+            }
+            add(record);
+        });
+        sealedSequence = segment.sequence;
+        sealed = true;
+    }
+    if (sealed) {
+        logOffset = 0;
+        liveRecords = 0;
+    }
+
+    std::FILE* file = std::fopen(logFilePath.c_str(), "rb");
+    if (!file) {
+        if (sealed) flush();
+        return;
+    }
+
+    uint64_t logSize = fileSize(file);
+    if (logSize < logOffset) {
+        // Replaced by something other than rotation
+        std::fclose(file);
+        rebuild();
+        return;
+    }
+    if (logSize == logOffset || !seekFile(file, logOffset)) {
+        std::fclose(file);
+        if (sealed) flush();
+        return;
+    }
+
+    std::vector<char> buffer(1 << 20);
+    std::string carry;
+    LogRecord record;
+    size_t bytesRead;
+    while ((bytesRead = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        const char* begin = buffer.data();
+        const char* end = begin + bytesRead;
+        while (begin < end) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!newline) {
+                carry.append(begin, end);
+                break;
+            }
+            bool parsed;
+            if (!carry.empty()) {
+                carry.append(begin, newline);
+                parsed = parseLogLine(carry.data(), carry.size(), record);
+                logOffset += carry.size() + 1;
+                carry.clear();
+            } else {
+                parsed = parseLogLine(begin, newline - begin, record);
+                logOffset += static_cast<uint64_t>(newline - begin) + 1;
+            }
+            if (parsed) {
+                add(record);
+                liveRecords++;
+            }
+            begin = newline + 1;
+        }
+    }
+    // A trailing line without newline is still being written; index it next time
+    std::fclose(file);
+    flush();
+}
+
+void SessionIndex::rebuild() {
+    closeReaders();
+    std::error_code error;
+    std::filesystem::remove_all(indexDir, error);
+    sealedSequence = 0;
+    liveRecords = 0;
+    logOffset = 0;
+    docCount = 0;
+    blockTotal = 0;
+    stale = false;
+    open = false;
+    current = OpenSession();
+    terms.clear();
+    days.clear();
+    update();
+}
+
+bool SessionIndex::readSession(uint32_t doc, Session& out) {
+    if (doc == docCount && open) {
+        out = current.session;
+        return true;
+    }
+    if (doc >= docCount) return false;
+    if (!docsReader) docsReader = std::fopen((indexDir + "/docs.bin").c_str(), "rb");
+    char data[docSize];
+    if (!docsReader || !seekFile(docsReader, static_cast<uint64_t>(doc) * docSize) ||
+        std::fread(data, sizeof(data), 1, docsReader) != 1) {
+        return false;
+    }
+    decodeSession(data, out);
+    return true;
+}
+
+bool SessionIndex::readBlock(uint32_t block, LogRecord& out) {
+    if (block >= blockTotal) return false;
+    if (!blocksReader) blocksReader = std::fopen((indexDir + "/blocks.bin").c_str(), "rb");
+    char data[blockSize];
+    if (!blocksReader || !seekFile(blocksReader, static_cast<uint64_t>(block) * blockSize) ||
+        std::fread(data, sizeof(data), 1, blocksReader) != 1) {
+        return false;
+    }
+    out.timestamp = readValue<int64_t>(data, 0);
+    out.value = readValue<uint32_t>(data, 8);
+    out.tagId = readValue<uint32_t>(data, 12);
+    out.event = static_cast<LogEvent>(readValue<uint8_t>(data, 16));
+    out.rating = static_cast<Rating>(readValue<uint8_t>(data, 17));
+    return true;
+}
+
+bool SessionIndex::matchesOpen(const Query& query) const {
+    const Session& session = current.session;
+    int32_t day = epochDay(session.start);
+    if (query.from != INT64_MIN && day < epochDay(query.from)) return false;
+    if (query.to != INT64_MAX && day > epochDay(query.to)) return false;
+    if (!query.tags.empty() &&
+        std::none_of(query.tags.begin(), query.tags.end(), [this](uint32_t tag) {
+            return std::find(current.tags.begin(), current.tags.end(), tag) != current.tags.end();
+        })) {
+        return false;
+    }
+    if (!query.ratings.empty() &&
+        std::none_of(query.ratings.begin(), query.ratings.end(), [&session](Rating rating) {
+            return (rating == Rating::Good && session.good > 0) || (rating == Rating::Bad && session.bad > 0) ||
+                   (rating == Rating::Okay && session.okay > 0);
+        })) {
+        return false;
+    }
+    return query.events.empty() || std::find(query.events.begin(), query.events.end(), session.terminal) != query.events.end();
+}
+
+std::vector<uint32_t> SessionIndex::search(const Query& query) {
+    update();
+
+    // Date range -> contiguous id range
+    uint32_t lo = 0;
+    uint32_t hi = docCount;
+    if (query.from != INT64_MIN) {
+        int32_t fromDay = epochDay(query.from);
+        auto it = std::lower_bound(days.begin(), days.end(), std::make_pair(fromDay, 0u));
+        lo = it != days.end() ? it->second : docCount;
+    }
+    if (query.to != INT64_MAX) {
+        int32_t toDay = epochDay(query.to);
+        auto it = std::upper_bound(days.begin(), days.end(), std::make_pair(toDay, UINT32_MAX));
+        hi = it != days.end() ? it->second : docCount;
+    }
+
+    // One cursor per filter over the union of its terms
+    std::vector<std::string> groups[3];
+    for (uint32_t tag : query.tags) groups[0].push_back(tagTerm(tag));
+    for (Rating rating : query.ratings) groups[1].push_back(ratingTerm(rating));
+    for (LogEvent event : query.events) groups[2].push_back(stateTerm(event));
+
+    std::vector<std::unique_ptr<AnyCursor>> cursors;
+    for (const auto& group : groups) {
+        if (group.empty()) continue;
+        auto cursor = std::make_unique<AnyCursor>();
+        for (const std::string& term : group) {
+            auto it = terms.find(term);
+            if (it == terms.end() || it->second.count == 0) continue;
+            cursor->add(std::make_unique<PostingCursor>(termPath(term, ".post"), termPath(term, ".skip"),
+                                                        it->second.count, it->second.bytes),
+                        it->second.count);
+        }
+        cursors.push_back(std::move(cursor));
+    }
+    std::sort(cursors.begin(), cursors.end(),
+              [](const std::unique_ptr<AnyCursor>& a, const std::unique_ptr<AnyCursor>& b) { return a->cost() < b->cost(); });
+
+    std::vector<uint32_t> result;
+    if (cursors.empty()) {
+        for (uint32_t doc = lo; doc < hi; ++doc) result.push_back(doc);
+    } else {
+        // Leapfrog: every cursor jumps to the candidate until all agree
+        uint32_t doc = lo;
+        while (doc < hi) {
+            doc = cursors[0]->seek(doc);
+            if (doc >= hi) break;
+            bool all = true;
+            for (size_t i = 1; i < cursors.size(); ++i) {
+                uint32_t other = cursors[i]->seek(doc);
+                if (other != doc) {
+                    doc = other;
+                    all = false;
+                    break;
+                }
+            }
+            if (all) result.push_back(doc++);
+        }
+    }
+    if (open && matchesOpen(query)) {
+        result.push_back(docCount);
+    }
+    return result;
+}
+
+std::string formatSession(const SessionIndex::Session& session, const std::string& tagName) {
+    std::string text = formatEpoch(session.start).substr(0, 16) + "-" + formatEpoch(session.end).substr(11, 5) + "  " +
+                       std::to_string(session.blocks) + (session.blocks == 1 ? " block" : " blocks");
+    if (session.focusMinutes > 0) text += ", " + std::to_string(session.focusMinutes) + " min focus";
+    if (session.hyperfocusMinutes > 0) text += ", " + std::to_string(session.hyperfocusMinutes) + " min hyperfocus";
+    if (session.good > 0) text += ", " + std::to_string(session.good) + " good";
+    if (session.bad > 0) text += ", " + std::to_string(session.bad) + " bad";
+    if (session.okay > 0) text += ", " + std::to_string(session.okay) + " okay";
+    text += ", state " + std::string(eventName(session.terminal));
+    if (!tagName.empty()) text += "  [" + tagName + "]";
+    return text;
+}
+
+namespace {
+
+void splitValues(const std::string& text, std::vector<std::string>& out) {
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) comma = text.size();
+        if (comma > start) out.push_back(text.substr(start, comma - start));
+        start = comma + 1;
+    }
+}
+
+bool parseRating(std::string text, Rating& out) {
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    for (int r = static_cast<int>(Rating::Good); r < static_cast<int>(Rating::Count); ++r) {
+        std::string name = ratingName(static_cast<Rating>(r));
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name == text) {
+            out = static_cast<Rating>(r);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseState(std::string text, LogEvent& out) {
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    for (int e = 0; e < static_cast<int>(LogEvent::Count); ++e) {
+        if (text == eventName(static_cast<LogEvent>(e))) {
+            out = static_cast<LogEvent>(e);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int runQueryCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI query [tag=NAME[,NAME]] [rating=good|bad|okay] "
+        "[state=focus|hyperfocus|rest|idle|finished|quit] [from=YYYY-MM-DD] [to=YYYY-MM-DD] [--count] [--rebuild]";
+
+    SessionIndex::Query query;
+    bool countOnly = false;
+    bool rebuild = false;
+    bool unknownTag = false;
+    TagTable tags;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = eq == std::string::npos ? arg : arg.substr(0, eq);
+        std::vector<std::string> values;
+        if (eq != std::string::npos) splitValues(arg.substr(eq + 1), values);
+
+        if (arg == "--count") {
+            countOnly = true;
+        } else if (arg == "--rebuild") {
+            rebuild = true;
+        } else if (key == "tag" && !values.empty()) {
+            for (const std::string& value : values) {
+                uint32_t id = tags.find(value);
+                if (id == 0) unknownTag = true;
+                else query.tags.push_back(id);
+            }
+        } else if (key == "rating" && !values.empty()) {
+            for (const std::string& value : values) {
+                Rating rating;
+                if (!parseRating(value, rating)) {
+                    std::cerr << "Unknown rating: " << value << "\n" << usage << std::endl;
+                    return 1;
+                }
+                query.ratings.push_back(rating);
+            }
+        } else if (key == "state" && !values.empty()) {
+            for (const std::string& value : values) {
+                LogEvent event;
+                if (!parseState(value, event)) {
+                    std::cerr << "Unknown state: " << value << "\n" << usage << std::endl;
+                    return 1;
+                }
+                query.events.push_back(event);
+            }
+        } else if ((key == "from" || key == "to") && values.size() == 1) {
+            int64_t epoch;
+            if (!parseEpoch(values[0].data(), values[0].size(), epoch)) {
+                std::cerr << "Invalid date: " << values[0] << "\n" << usage << std::endl;
+                return 1;
+            }
+            (key == "from" ? query.from : query.to) = epoch;
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    SessionIndex index;
+    if (rebuild) {
+        index.rebuild();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> docs;
+    if (!unknownTag || !query.tags.empty()) {
+        docs = index.search(query);
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (!countOnly) {
+        SessionIndex::Session session;
+        for (uint32_t doc : docs) {
+            if (index.readSession(doc, session)) {
+                std::cout << formatSession(session, session.tagId != 0 ? tags.name(session.tagId) : "") << "\n";
+            }
+        }
+    }
+    std::cout << docs.size() << " session(s) of " << index.size() << " in " << elapsed << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * On-disk inverted index over the sessions of the history: the sealed
+ * segments of log.txt (see LogArchive.h) followed by the live log.
+ *
+ * A session runs from "Session started" to "Session finished" or
+ * "Application quit" (or the next start) and is one document, numbered in
+ * log order. Its terminal state is the last Focus, Hyperfocus, Rest or Idle
+ * block, or how it ended if it has none. The index directory holds:
+ *   meta.txt          last indexed segment, records and offset indexed in
+ *                     the live log, counts, the open session and per term
+ *                     the last id, posting count and file size
+ *   docs.bin          a fixed-size summary per session (times, minutes,
+ *                     ratings, terminal state, first tag)
+ *   blocks.bin        every Focus/Hyperfocus record (fixed size), so the
+ *                     n-th block can be fetched without reading the log
+ *   days.bin          (day, first id) pairs; sessions are chronological, so
+ *                     a day range is an id range
+ *   <term>.post       delta + varint encoded posting lists for
+ *                     tag-<id>, rating-<good|bad|okay> and state-<event>
+ *   <term>.skip       (first id, byte offset) of every 128 postings
+ *
+ * Queries open a cursor per term and leapfrog between them; a cursor jumps
+ * with a binary search over the skip entries and decodes one block, so a
+ * query reads only the blocks around its matches and date range.
+ *
+ * The index catches up with the log incrementally from the last indexed
+ * offset, so both the CLI and the GUI keep it current by calling update()
+ * after writing. When log.txt has been sealed meanwhile, the rest of it is
+ * read from its segment (text or archive) by record count, then any later
+ * segments and the new log.txt. The session still being logged is kept in meta.txt and
+ * becomes a document when it ends; queries already include it.
+ */
+class SessionIndex {
+public:
+    explicit SessionIndex(const std::string& logPath = "log.txt", const std::string& indexPath = "log.index");
+    ~SessionIndex();
+
+    SessionIndex(const SessionIndex&) = delete;
+    SessionIndex& operator=(const SessionIndex&) = delete;
+
+    struct Session {
+        int64_t start = 0;
+        int64_t end = 0;                // time of the last record
+        uint32_t focusMinutes = 0;
+        uint32_t hyperfocusMinutes = 0;
+        uint32_t blocks = 0;            // Focus/Hyperfocus records
+        uint32_t good = 0;
+        uint32_t bad = 0;
+        uint32_t okay = 0;
+        uint32_t tagId = 0;             // first tag used in the session
+        LogEvent terminal = LogEvent::SessionStarted;
+    };
+
+    // Index records appended to the history since the last update (rebuilds if the log was
+    // replaced other than by rotation)
+    void update();
+    void rebuild();
+
+    // Sessions including the one still open
+    uint32_t size() const { return docCount + (open ? 1 : 0); }
+    uint32_t blockCount() const { return blockTotal; }
+
+    bool readSession(uint32_t doc, Session& out);
+    // The n-th Focus/Hyperfocus record of the history
+    bool readBlock(uint32_t block, LogRecord& out);
+
+    struct Query {
+        std::vector<uint32_t> tags;     // any of (empty = no restriction)
+        std::vector<Rating> ratings;    // any of
+        std::vector<LogEvent> events;   // terminal state, any of
+        int64_t from = INT64_MIN;       // inclusive, day granularity
+        int64_t to = INT64_MAX;         // inclusive, day granularity
+    };
+    // Ids of matching sessions in ascending order
+    std::vector<uint32_t> search(const Query& query);
+
+private:
+    struct TermState {
+        int64_t last = -1;              // last id written
+        uint32_t count = 0;             // postings
+        uint64_t bytes = 0;             // size of the .post file
+    };
+
+    struct OpenSession {
+        Session session;
+        std::vector<uint32_t> tags;
+    };
+
+    std::string logFilePath;
+    std::string indexDir;
+
+    uint32_t sealedSequence;                            // last segment indexed
+    uint64_t liveRecords;                               // records indexed from the live log
+    uint64_t logOffset;                                 // bytes indexed from the live log
+    uint32_t docCount;
+    uint32_t blockTotal;
+    bool stale;                                         // written by an older version
+    bool open;
+    OpenSession current;
+    std::map<std::string, TermState> terms;
+    std::vector<std::pair<int32_t, uint32_t>> days;     // day -> first id
+
+    // Writes buffered during update() and flushed at the end
+    std::map<std::string, std::string> pendingPostings;
+    std::map<std::string, std::string> pendingSkips;
+    std::string pendingDocs;
+    std::string pendingBlocks;
+    std::string pendingDays;
+
+    std::FILE* docsReader;
+    std::FILE* blocksReader;
+
+    void add(const LogRecord& record);
+    void closeSession();
+    void addPosting(const std::string& term, uint32_t doc);
+    bool matchesOpen(const Query& query) const;
+    void flush();
+    void loadMeta();
+    void saveMeta() const;
+    void closeReaders();
+    std::string termPath(const std::string& term, const char* extension) const;
+};
+
+// Term names used in the index
+std::string tagTerm(uint32_t tagId);
+std::string ratingTerm(Rating rating);
+std::string stateTerm(LogEvent event);
+
+// "2025-07-03 09:12-11:40  4 blocks, 100 min focus, 2 good 1 bad, ends in hyperfocus  [tag]"
+std::string formatSession(const SessionIndex::Session& session, const std::string& tagName);
+
+// "ADHDPomodoro-CLI query [tag=..] [rating=..] [state=..] [from=YYYY-MM-DD] [to=YYYY-MM-DD] [--count]"
+int runQueryCommand(int argc, char* argv[]);
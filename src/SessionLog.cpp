@@ -0,0 +1,539 @@
+#include "SessionLog.h"
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#ifndef _WIN32
+#include <sys/file.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+const char* const ratingNames[] = { "", "Good", "Bad", "Okay" };
+
+const char* const eventNames[] = {
+    "started", "paused", "resumed", "finished", "newfocus", "focus",
+    "enteredhyperfocus", "hyperfocus", "rest", "idle", "quit"
+};
+
+bool startsWith(const char* text, size_t length, const char* prefix, size_t prefixLength) {
+    return length >= prefixLength && std::memcmp(text, prefix, prefixLength) == 0;
+}
+
+#define LITERAL(s) s, sizeof(s) - 1
+
+// Parse an unsigned decimal number, advancing pos
+bool parseNumber(const char* text, size_t length, size_t& pos, uint32_t& out) {
+    size_t start = pos;
+    uint32_t value = 0;
+    while (pos < length && text[pos] >= '0' && text[pos] <= '9') {
+        value = value * 10 + static_cast<uint32_t>(text[pos] - '0');
+        ++pos;
+    }
+    out = value;
+    return pos > start;
+}
+
+// Parse "N min" and require that nothing else follows (after the optional rating)
+bool parseMinutes(const char* text, size_t length, size_t pos, uint32_t& out, size_t& end) {
+    if (!parseNumber(text, length, pos, out)) return false;
+    if (!startsWith(text + pos, length - pos, LITERAL(" min"))) return false;
+    end = pos + 4;
+    return true;
+}
+
+// Parse "MM:SS" into seconds
+bool parseClock(const char* text, size_t length, size_t pos, uint32_t& out) {
+    uint32_t minutes = 0, seconds = 0;
+    if (!parseNumber(text, length, pos, minutes)) return false;
+    if (pos >= length || text[pos] != ':') return false;
+    ++pos;
+    if (!parseNumber(text, length, pos, seconds)) return false;
+    out = minutes * 60 + seconds;
+    return true;
+}
+
+int digit(char c) {
+    return (c >= '0' && c <= '9') ? c - '0' : -1;
+}
+
+bool parseFixed(const char* text, int width, int& out) {
+    int value = 0;
+    for (int i = 0; i < width; ++i) {
+        int d = digit(text[i]);
+        if (d < 0) return false;
+        value = value * 10 + d;
+    }
+    out = value;
+    return true;
+}
+
+void appendNumber(std::string& out, uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) out.push_back(digits[--count]);
+}
+
+void appendPadded(std::string& out, int value, int width) {
+    char digits[8];
+    for (int i = width - 1; i >= 0; --i) {
+        digits[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    out.append(digits, width);
+}
+
+void appendClock(std::string& out, uint32_t seconds) {
+    uint32_t minutes = seconds / 60;
+    if (minutes < 10) out.push_back('0');
+    appendNumber(out, minutes);
+    out.push_back(':');
+    appendPadded(out, static_cast<int>(seconds % 60), 2);
+}
+
+// "YYYY-MM-DD HH:MM:SS" without a temporary string (every log line starts with one)
+void appendEpoch(std::string& out, int64_t epoch) {
+    int year, month, day, hour, minute, second;
+    epochToCivil(epoch, year, month, day, hour, minute, second);
+    appendPadded(out, year, 4);
+    out.push_back('-');
+    appendPadded(out, month, 2);
+    out.push_back('-');
+    appendPadded(out, day, 2);
+    out.push_back(' ');
+    appendPadded(out, hour, 2);
+    out.push_back(':');
+    appendPadded(out, minute, 2);
+    out.push_back(':');
+    appendPadded(out, second, 2);
+}
+
+} // namespace
+
+// Days-from-civil algorithm (proleptic Gregorian calendar)
+int64_t civilToEpoch(int year, int month, int day, int hour, int minute, int second) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    const int64_t days = era * 146097 + static_cast<int64_t>(doe) - 719468;
+    return days * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+void epochToCivil(int64_t epoch, int& year, int& month, int& day, int& hour, int& minute, int& second) {
+    int64_t days = epoch / 86400;
+    int64_t rem = epoch % 86400;
+    if (rem < 0) {
+        rem += 86400;
+        --days;
+    }
+    hour = static_cast<int>(rem / 3600);
+    minute = static_cast<int>(rem % 3600 / 60);
+    second = static_cast<int>(rem % 60);
+
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe + era * 400 + (month <= 2));
+}
+
+int64_t localNow() {
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+    return civilToEpoch(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+                        local.tm_hour, local.tm_min, local.tm_sec);
+}
+
+std::string formatEpoch(int64_t epoch) {
+    std::string out;
+    out.reserve(19);
+    appendEpoch(out, epoch);
+    return out;
+}
+
+bool parseEpoch(const char* text, size_t length, int64_t& out) {
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (length < 10 || text[4] != '-' || text[7] != '-') return false;
+    if (!parseFixed(text, 4, year) || !parseFixed(text + 5, 2, month) || !parseFixed(text + 8, 2, day)) return false;
+    if (length >= 16) {
+        if ((text[10] != ' ' && text[10] != 'T') || text[13] != ':') return false;
+        if (!parseFixed(text + 11, 2, hour) || !parseFixed(text + 14, 2, minute)) return false;
+        if (length >= 19) {
+            if (text[16] != ':' || !parseFixed(text + 17, 2, second)) return false;
+        }
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+    out = civilToEpoch(year, month, day, hour, minute, second);
+    return true;
+}
+
+int32_t epochDay(int64_t epoch) {
+    int64_t days = epoch / 86400;
+    if (epoch % 86400 < 0) --days;
+    return static_cast<int32_t>(days);
+}
+
+uint32_t epochMonth(int64_t epoch) {
+    int year, month, day, hour, minute, second;
+    epochToCivil(epoch, year, month, day, hour, minute, second);
+    return static_cast<uint32_t>(year * 100 + month);
+}
+
+const char* ratingName(Rating rating) {
+    return ratingNames[static_cast<int>(rating)];
+}
+
+const char* eventName(LogEvent event) {
+    return eventNames[static_cast<int>(event)];
+}
+
+bool parseLogLine(const char* line, size_t length, LogRecord& out) {
+    while (length > 0 && (line[length - 1] == '\r' || line[length - 1] == '\n')) --length;
+    if (length < 23 || line[19] != ' ' || line[20] != '-' || line[21] != ' ') return false;
+    if (!parseEpoch(line, 19, out.timestamp)) return false;
+
+    // Optional " [#id]" tag suffix
+    out.tagId = 0;
+    if (line[length - 1] == ']') {
+        size_t open = length - 1;
+        while (open > 22 && line[open] != '[') --open;
+        if (open > 23 && line[open - 1] == ' ' && line[open + 1] == '#') {
+            size_t pos = open + 2;
+            uint32_t tag = 0;
+            if (parseNumber(line, length - 1, pos, tag) && pos == length - 1) {
+                out.tagId = tag;
+                length = open - 1;
+            }
+        }
+    }
+
+    const char* text = line + 22;
+    const size_t textLength = length - 22;
+    size_t end = 0;
+    out.rating = Rating::None;
+    out.value = 0;
+
+    if (startsWith(text, textLength, LITERAL("Focus: "))) {
+        if (!parseMinutes(text, textLength, 7, out.value, end)) return false;
+        const char* rating = text + end;
+        const size_t ratingLength = textLength - end;
+        out.event = LogEvent::Focus;
+        if (ratingLength == 7 && std::memcmp(rating, " (Good)", 7) == 0) out.rating = Rating::Good;
+        else if (ratingLength == 6 && std::memcmp(rating, " (Bad)", 6) == 0) out.rating = Rating::Bad;
+        else if (ratingLength == 7 && std::memcmp(rating, " (Okay)", 7) == 0) out.rating = Rating::Okay;
+        else return false;
+        return true;
+    }
+    if (startsWith(text, textLength, LITERAL("Hyperfocus: "))) {
+        out.event = LogEvent::Hyperfocus;
+        return parseMinutes(text, textLength, 12, out.value, end) && end == textLength;
+    }
+    if (startsWith(text, textLength, LITERAL("Rest: "))) {
+        out.event = LogEvent::Rest;
+        return parseMinutes(text, textLength, 6, out.value, end) && end == textLength;
+    }
+    if (startsWith(text, textLength, LITERAL("Idle: "))) {
+        out.event = LogEvent::Idle;
+        return parseMinutes(text, textLength, 6, out.value, end) && end == textLength;
+    }
+    if (startsWith(text, textLength, LITERAL("Session paused at "))) {
+        out.event = LogEvent::SessionPaused;
+        return parseClock(text, textLength, 18, out.value);
+    }
+    if (startsWith(text, textLength, LITERAL("Session finished at "))) {
+        out.event = LogEvent::SessionFinished;
+        return parseClock(text, textLength, 20, out.value);
+    }
+
+    struct Fixed { const char* text; size_t length; LogEvent event; };
+    static const Fixed fixedEvents[] = {
+        { LITERAL("Session started"), LogEvent::SessionStarted },
+        { LITERAL("Session resumed"), LogEvent::SessionResumed },
+        { LITERAL("New focus session started"), LogEvent::NewFocus },
+        { LITERAL("Entered hyperfocus mode"), LogEvent::EnteredHyperfocus },
+        { LITERAL("Application quit"), LogEvent::Quit },
+    };
+    for (const Fixed& fixed : fixedEvents) {
+        if (textLength == fixed.length && std::memcmp(text, fixed.text, fixed.length) == 0) {
+            out.event = fixed.event;
+            return true;
+        }
+    }
+    return false;
+}
+
+void appendLogLine(const LogRecord& record, std::string& out) {
+    appendEpoch(out, record.timestamp);
+    out += " - ";
+    switch (record.event) {
+        case LogEvent::SessionStarted:
+            out += "Session started";
+            break;
+        case LogEvent::SessionPaused:
+            out += "Session paused at ";
+            appendClock(out, record.value);
+            break;
+        case LogEvent::SessionResumed:
+            out += "Session resumed";
+            break;
+        case LogEvent::SessionFinished:
+            out += "Session finished at ";
+            appendClock(out, record.value);
+            break;
+        case LogEvent::NewFocus:
+            out += "New focus session started";
+            break;
+        case LogEvent::Focus:
+            out += "Focus: ";
+            appendNumber(out, record.value);
+            out += " min (";
+            out += ratingName(record.rating);
+            out += ")";
+            break;
+        case LogEvent::EnteredHyperfocus:
+            out += "Entered hyperfocus mode";
+            break;
+        case LogEvent::Hyperfocus:
+            out += "Hyperfocus: ";
+            appendNumber(out, record.value);
+            out += " min";
+            break;
+        case LogEvent::Rest:
+            out += "Rest: ";
+            appendNumber(out, record.value);
+            out += " min";
+            break;
+        case LogEvent::Idle:
+            out += "Idle: ";
+            appendNumber(out, record.value);
+            out += " min";
+            break;
+        case LogEvent::Quit:
+        case LogEvent::Count:
+            out += "Application quit";
+            break;
+    }
+    if (record.tagId != 0) {
+        out += " [#";
+        appendNumber(out, record.tagId);
+        out += "]";
+    }
+}
+
+std::string formatLogLine(const LogRecord& record) {
+    std::string line;
+    appendLogLine(record, line);
+    return line;
+}
+
+bool forEachLogRecord(const std::string& path, const std::function<void(const LogRecord&)>& callback) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    std::vector<char> buffer(1 << 20);
+    std::string carry;
+    LogRecord record;
+    size_t bytesRead;
+    while ((bytesRead = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        const char* begin = buffer.data();
+        const char* end = begin + bytesRead;
+        while (begin < end) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!newline) {
+                carry.append(begin, end);
+                break;
+            }
+            if (!carry.empty()) {
+                carry.append(begin, newline);
+                if (parseLogLine(carry.data(), carry.size(), record)) callback(record);
+                carry.clear();
+            } else if (parseLogLine(begin, newline - begin, record)) {
+                callback(record);
+            }
+            begin = newline + 1;
+        }
+    }
+    if (!carry.empty() && parseLogLine(carry.data(), carry.size(), record)) {
+        callback(record);
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool seekFile(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+uint64_t fileSize(std::FILE* file) {
+#ifdef _WIN32
+    if (_fseeki64(file, 0, SEEK_END) != 0) return 0;
+    __int64 size = _ftelli64(file);
+#else
+    if (fseeko(file, 0, SEEK_END) != 0) return 0;
+    off_t size = ftello(file);
+#endif
+    return size > 0 ? static_cast<uint64_t>(size) : 0;
+}
+
+void lockFile(std::FILE* file) {
+#ifndef _WIN32
+    while (flock(fileno(file), LOCK_EX) != 0 && errno == EINTR) {}
+#else
+    (void)file;
+#endif
+}
+
+void unlockFile(std::FILE* file) {
+#ifndef _WIN32
+    flock(fileno(file), LOCK_UN);
+#else
+    (void)file;
+#endif
+}
+
+bool isSameFile(std::FILE* file, const std::string& path) {
+#ifndef _WIN32
+    struct stat opened, named;
+    return fstat(fileno(file), &opened) == 0 && stat(path.c_str(), &named) == 0 &&
+           opened.st_dev == named.st_dev && opened.st_ino == named.st_ino;
+#else
+    (void)file;
+    (void)path;
+    return true;
+#endif
+}
+
+bool parseOptionValue(const std::string& text, double& out) {
+    if (text.empty() || std::isspace(static_cast<unsigned char>(text[0]))) return false;
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtod(text.c_str(), &end);
+    return errno == 0 && end == text.c_str() + text.size() && std::isfinite(out);
+}
+
+SessionLogger::SessionLogger(const std::string& path)
+    : logFilePath(path), logFile(nullptr), currentTag(0), rotateBytes(0), rotateMonthly(false), fileMonth(0) {
+    if (path.empty()) return;
+    openFile();
+}
+
+SessionLogger::~SessionLogger() {
+    close();
+}
+
+void SessionLogger::openFile() {
+    logFile = std::fopen(logFilePath.c_str(), "a");
+    if (!logFile) {
+        std::cerr << "Error: Could not open log file " << logFilePath << std::endl;
+        return;
+    }
+    fileMonth = 0;
+    std::ifstream existing(logFilePath, std::ios::binary);
+    std::string line;
+    LogRecord record;
+    if (std::getline(existing, line) && parseLogLine(line, record)) {
+        fileMonth = epochMonth(record.timestamp);
+    }
+}
+
+void SessionLogger::addListener(Listener listener) {
+    listeners.push_back(std::move(listener));
+}
+
+void SessionLogger::setRotation(uint64_t maxBytes, bool monthly, std::function<bool(const std::string&)> onSeal) {
+    rotateBytes = maxBytes;
+    rotateMonthly = monthly;
+    sealHandler = std::move(onSeal);
+}
+
+void SessionLogger::lockCurrentFile() {
+    lockFile(logFile);
+    while (!isSameFile(logFile, logFilePath)) {
+        // Sealed by another process; append to the log.txt that replaced it
+        unlockFile(logFile);
+        std::fclose(logFile);
+        openFile();
+        if (!logFile) return;
+        lockFile(logFile);
+    }
+}
+
+void SessionLogger::rotate() {
+    // The seal handler locks the file itself
+    unlockFile(logFile);
+    std::fclose(logFile);
+    bool sealed = sealHandler(logFilePath);
+    openFile();
+    if (logFile) lockCurrentFile();
+    if (!sealed) {
+        // Keep appending rather than retrying on every write
+        std::cerr << "Error: Could not rotate " << logFilePath << ", rotation disabled" << std::endl;
+        sealHandler = nullptr;
+    }
+}
+
+void SessionLogger::log(LogEvent event, uint32_t value, Rating rating) {
+    if (!logFile && listeners.empty()) return;
+    LogRecord record;
+    record.timestamp = localNow();
+    record.event = event;
+    record.rating = rating;
+    record.value = value;
+    record.tagId = currentTag;
+    write(record);
+}
+
+void SessionLogger::write(const LogRecord& record) {
+    if (logFile) {
+        lineBuffer.clear();
+        appendLogLine(record, lineBuffer);
+        lineBuffer.push_back('\n');
+        lockCurrentFile();
+    }
+    if (logFile) {
+        // Other processes may append too, so the size is read under the lock
+        const uint64_t fileBytes = fileSize(logFile);
+        if (sealHandler && fileBytes > 0 &&
+            ((rotateBytes > 0 && fileBytes + lineBuffer.size() > rotateBytes) ||
+             (rotateMonthly && fileMonth != 0 && epochMonth(record.timestamp) != fileMonth))) {
+            rotate();
+        }
+    }
+    if (logFile) {
+        std::fwrite(lineBuffer.data(), 1, lineBuffer.size(), logFile);
+        std::fflush(logFile);
+        if (fileMonth == 0) fileMonth = epochMonth(record.timestamp);
+        unlockFile(logFile);
+    }
+
+    for (const Listener& listener : listeners) {
+        listener(record);
+    }
+}
+
+void SessionLogger::close() {
+    if (logFile) {
+        std::fclose(logFile);
+        logFile = nullptr;
+    }
+}
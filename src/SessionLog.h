@@ -0,0 +1,147 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Session log records shared by the CLI and GUI versions.
+ *
+ * Every line in log.txt has the form
+ *   "YYYY-MM-DD HH:MM:SS - <event text>[ [#<tag id>]]"
+ * where the optional suffix references a tag interned in tags.txt.
+ */
+
+// Kind of event a log line describes
+enum class LogEvent : uint8_t {
+    SessionStarted,     // "Session started"
+    SessionPaused,      // "Session paused at MM:SS"
+    SessionResumed,     // "Session resumed"
+    SessionFinished,    // "Session finished at MM:SS"
+    NewFocus,           // "New focus session started"
+    Focus,              // "Focus: N min (Good|Bad|Okay)"
+    EnteredHyperfocus,  // "Entered hyperfocus mode"
+    Hyperfocus,         // "Hyperfocus: N min"
+    Rest,               // "Rest: N min"
+    Idle,               // "Idle: N min"
+    Quit,               // "Application quit"
+    Count
+};
+
+// Session rating given in ExtendedFocus
+enum class Rating : uint8_t {
+    None,
+    Good,
+    Bad,
+    Okay,
+    Count
+};
+
+// One parsed log line
+struct LogRecord {
+    int64_t timestamp = 0;           // local wall-clock time as seconds since 1970-01-01
+    LogEvent event = LogEvent::SessionStarted;
+    Rating rating = Rating::None;
+    uint32_t value = 0;              // minutes for Focus/Hyperfocus/Rest/Idle, seconds for paused/finished
+    uint32_t tagId = 0;              // 0 = untagged
+};
+
+// Local wall-clock helpers (no time zone conversion, timestamps are taken as written)
+int64_t civilToEpoch(int year, int month, int day, int hour = 0, int minute = 0, int second = 0);
+void epochToCivil(int64_t epoch, int& year, int& month, int& day, int& hour, int& minute, int& second);
+int64_t localNow();
+std::string formatEpoch(int64_t epoch);                        // "YYYY-MM-DD HH:MM:SS"
+bool parseEpoch(const char* text, size_t length, int64_t& out); // accepts "YYYY-MM-DD[ HH:MM[:SS]]"
+int32_t epochDay(int64_t epoch);                               // days since 1970-01-01
+uint32_t epochMonth(int64_t epoch);                            // YYYYMM
+
+const char* ratingName(Rating rating);
+const char* eventName(LogEvent event);
+
+// Parse a single log line; returns false for lines that are not session records
+bool parseLogLine(const char* line, size_t length, LogRecord& out);
+inline bool parseLogLine(const std::string& line, LogRecord& out) {
+    return parseLogLine(line.data(), line.size(), out);
+}
+
+// Append the textual form of a record (without trailing newline) to out
+void appendLogLine(const LogRecord& record, std::string& out);
+std::string formatLogLine(const LogRecord& record);
+
+// Stream every record of a log file in order; returns false if the file cannot be opened
+bool forEachLogRecord(const std::string& path, const std::function<void(const LogRecord&)>& callback);
+
+// 64-bit file positions (fseek and ftell take a long, which is 32 bits on Windows)
+bool seekFile(std::FILE* file, uint64_t offset);
+uint64_t fileSize(std::FILE* file);     // leaves the position at the end
+
+// Advisory exclusive lock held by log writers, seal and compaction so that another
+// process never appends to a log that has been sealed (no-op on Windows, where an
+// open log cannot be renamed)
+void lockFile(std::FILE* file);
+void unlockFile(std::FILE* file);
+// Whether path still names the open file (false once it was renamed or removed)
+bool isSameFile(std::FILE* file, const std::string& path);
+
+// Command option values ("points=60"): the whole text must be a number that fits in T
+template <typename T>
+bool parseOptionValue(const std::string& text, T& out) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, out);
+    return !text.empty() && result.ec == std::errc() && result.ptr == end;
+}
+bool parseOptionValue(const std::string& text, double& out);
+
+/**
+ * Appends records to log.txt and notifies listeners (aggregates, indexes)
+ * of each record as it is written. Each write locks the file and follows
+ * log.txt if another process has sealed it meanwhile.
+ */
+class SessionLogger {
+public:
+    using Listener = std::function<void(const LogRecord&)>;
+
+    // An empty path writes no file (listeners only)
+    explicit SessionLogger(const std::string& path = "log.txt");
+    ~SessionLogger();
+
+    SessionLogger(const SessionLogger&) = delete;
+    SessionLogger& operator=(const SessionLogger&) = delete;
+
+    void setTag(uint32_t tagId) { currentTag = tagId; }
+    uint32_t getTag() const { return currentTag; }
+    const std::string& getPath() const { return logFilePath; }
+
+    void addListener(Listener listener);
+
+    // Close the file and start a new one when a write would take it past maxBytes
+    // or a record falls into a new month (0 / false = never); onSeal moves the
+    // closed file away before it is reopened and returns false if it could not
+    void setRotation(uint64_t maxBytes, bool monthly, std::function<bool(const std::string&)> onSeal);
+
+    // Stamp with the current time and the active tag, write and notify
+    void log(LogEvent event, uint32_t value = 0, Rating rating = Rating::None);
+    void write(const LogRecord& record);
+
+    void close();
+
+private:
+    std::string logFilePath;
+    std::FILE* logFile;
+    uint32_t currentTag;
+    std::vector<Listener> listeners;
+    std::string lineBuffer;
+
+    uint64_t rotateBytes;
+    bool rotateMonthly;
+    std::function<bool(const std::string&)> sealHandler;
+    uint32_t fileMonth;     // YYYYMM of the first record in the file, 0 = empty
+
+    void openFile();
+    // Lock the file, reopening log.txt first if it has been sealed meanwhile
+    void lockCurrentFile();
+    void rotate();
+};
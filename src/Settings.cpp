@@ -130,7 +130,7 @@ void Settings::saveSettings() {
     }
 }
 
-void Settings::drawMenuBar(sf::RenderWindow& window, sf::Font& font) {
+void Settings::drawMenuBar(sf::RenderTarget& target, sf::Font& font, const sf::Vector2i& mousePos) {
     if (settingsText.getFont() == nullptr) {
         initializeUIElements(font);
     }
@@ -143,15 +143,14 @@ void Settings::drawMenuBar(sf::RenderWindow& window, sf::Font& font) {
     settingsTextBounds.top -= 5;
 
     // Draw menu bar with a slight highlight when mouse is over settings
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
     if (mousePos.y < 30 && isPointInRect(mousePos, settingsTextBounds)) {
         menuBar.setFillColor(sf::Color(220, 220, 220));
     } else {
         menuBar.setFillColor(sf::Color(240, 240, 240));
     }
 
-    window.draw(menuBar);
-    window.draw(settingsText);
+    target.draw(menuBar);
+    target.draw(settingsText);
 
     if (isSettingsOpen && settingsWindow) {
         drawSettingsWindow();
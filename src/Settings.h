@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <fstream>
+#include <memory>
 #include <SFML/Graphics.hpp>
 
 class Settings {
@@ -8,7 +9,8 @@ public:
     Settings();
     void loadSettings();
     void saveSettings();
-    void drawMenuBar(sf::RenderWindow& window, sf::Font& font);
+    // mousePos in target coordinates, for the hover highlight
+    void drawMenuBar(sf::RenderTarget& target, sf::Font& font, const sf::Vector2i& mousePos);
     bool handleMenuClick(const sf::Vector2i& mousePos);
     void handleSettingsInput(sf::Event& event);
     
@@ -0,0 +1,382 @@
+#include "Simulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "CLISettings.h"
+#include "LogArchive.h"
+#include "PomodoroManager.h"
+
+namespace {
+
+const int64_t secondsPerDay = 86400;
+// A longer pause between two cycles starts a new session
+const int64_t maxBreakSeconds = 3 * 3600;
+
+// Appends cycles in log order and groups them into sessions
+class HistoryBuilder {
+public:
+    explicit HistoryBuilder(SimHistory& history) : history(history) {}
+
+    void add(const LogRecord& record) {
+        if (record.timestamp < lastEnd) return;     // out of order (e.g. an unsorted merge)
+        switch (record.event) {
+            case LogEvent::Focus:
+            case LogEvent::Hyperfocus: {
+                // Cycles never overlap (merged logs of two machines can claim the same time)
+                int64_t start = std::max(record.timestamp - static_cast<int64_t>(record.value) * 60, lastEnd);
+                if (open && !boundary && start - lastEnd <= maxBreakSeconds) {
+                    history.cycles.back().breakSeconds = static_cast<int32_t>(start - lastEnd);
+                } else {
+                    finishSession();
+                    history.sessions.push_back(SimSession{ static_cast<uint32_t>(history.cycles.size()), 0, 0 });
+                    sessionStarts.push_back(start);
+                    open = true;
+                }
+                int32_t focusSeconds = static_cast<int32_t>(std::max<int64_t>(0, record.timestamp - start));
+                history.cycles.push_back(SimCycle{ focusSeconds, 0, record.rating, record.event == LogEvent::Hyperfocus });
+                history.sessions.back().cycleCount++;
+                lastEnd = record.timestamp;
+                boundary = false;
+                break;
+            }
+            case LogEvent::Rest:
+            case LogEvent::Idle:
+                // Logged by the GUI; used for the break after the last cycle of a session
+                if (open && !boundary) history.cycles.back().breakSeconds += static_cast<int32_t>(record.value) * 60;
+                break;
+            case LogEvent::SessionStarted:
+            case LogEvent::SessionFinished:
+            case LogEvent::Quit:
+                boundary = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void finishSession() {
+        if (!open) return;
+        history.sessions.back().lengthSeconds = lastEnd + history.cycles.back().breakSeconds - sessionStarts.back();
+        open = false;
+    }
+
+    int64_t lastCycleEnd() const { return lastEnd; }
+
+    // Drop the sessions that start before cutoff
+    void trimBefore(int64_t cutoff) {
+        size_t first = static_cast<size_t>(
+            std::lower_bound(sessionStarts.begin(), sessionStarts.end(), cutoff) - sessionStarts.begin());
+        if (first == 0) return;
+        uint32_t dropped = first < history.sessions.size() ? history.sessions[first].firstCycle
+                                                            : static_cast<uint32_t>(history.cycles.size());
+        history.cycles.erase(history.cycles.begin(), history.cycles.begin() + dropped);
+        history.sessions.erase(history.sessions.begin(), history.sessions.begin() + first);
+        sessionStarts.erase(sessionStarts.begin(), sessionStarts.begin() + first);
+        for (SimSession& session : history.sessions) session.firstCycle -= dropped;
+    }
+
+private:
+    SimHistory& history;
+    std::vector<int64_t> sessionStarts;
+    int64_t lastEnd = 0;
+    bool open = false;
+    bool boundary = true;
+};
+
+struct Totals {
+    int64_t focus = 0;
+    int64_t onPlan = 0;
+    int64_t rest = 0;
+    int64_t idle = 0;
+    uint32_t cycles = 0;
+    uint32_t completed = 0;
+    uint32_t hyperfocus = 0;
+    uint32_t abandoned = 0;
+};
+
+// Replay one session on the virtual clock, adding to totals
+void replaySession(PomodoroManager& timer, const SimCycle* cycles, uint32_t count, int64_t length, Totals& totals) {
+    const PomodoroManager::TimePoint base{};
+    auto at = [&base](int64_t seconds) { return base + std::chrono::seconds(seconds); };
+    const int64_t focusLength = timer.getFocusDuration() * 60;
+    const int64_t restLength = timer.getRestDuration() * 60;
+
+    int64_t now = 0;
+    timer.start(at(now));
+    for (uint32_t i = 0; i < count && now < length; ++i) {
+        const SimCycle& cycle = cycles[i];
+        totals.cycles++;
+        int64_t end = std::min(now + cycle.focusSeconds, length);
+        if (end < now + focusLength) {
+            // Attention (or the session) ran out before the bell
+            timer.update(at(end));
+            totals.focus += timer.getElapsedSeconds();
+            timer.finish(at(end));
+            if (end == length) break;
+            totals.abandoned++;
+            int64_t back = std::min(end + cycle.breakSeconds, length);
+            totals.idle += back - end;
+            now = back;
+            if (now < length) timer.start(at(now));
+            continue;
+        }
+
+        timer.update(at(now + focusLength));    // bell: Focus -> ExtendedFocus
+        totals.onPlan += focusLength;
+        if (cycle.hyperfocus && timer.enterHyperfocus()) totals.hyperfocus++;
+        timer.update(at(end));
+        totals.focus += timer.getTotalFocusTime();
+        totals.completed++;
+        if (timer.getState() == State::Hyperfocus) {
+            timer.rest(at(end));
+        } else {
+            timer.rate(cycle.rating == Rating::None ? Rating::Okay : cycle.rating, at(end));
+        }
+
+        int64_t restEnd = std::min(end + restLength, length);
+        timer.update(at(restEnd));              // Rest -> IdleAfterRest
+        int64_t back = std::min(end + std::max<int64_t>(cycle.breakSeconds, restLength), length);
+        totals.rest += restEnd - end;
+        totals.idle += back - restEnd;
+        now = back;
+        if (now < length) timer.finish(at(now));    // next focus
+    }
+    // Stop the timer (from Rest/Idle finish first starts a new focus)
+    while (timer.isRunning()) timer.finish(at(now));
+}
+
+// Synthetic history for the benchmark: a few sessions a day of varied cycles
+SimHistory syntheticHistory(int years) {
+    std::mt19937 rng(7);
+    std::lognormal_distribution<double> focus(std::log(30.0), 0.5);
+    std::uniform_int_distribution<int> breakMinutes(3, 40);
+    std::uniform_int_distribution<int> sessionsPerDay(1, 4);
+    std::uniform_int_distribution<int> cyclesPerSession(1, 6);
+    std::uniform_real_distribution<double> unit(0, 1);
+
+    SimHistory history;
+    history.days = years * 365;
+    history.to = localNow();
+    history.from = history.to - history.days * secondsPerDay;
+    for (int day = 0; day < history.days; ++day) {
+        for (int s = sessionsPerDay(rng); s > 0; --s) {
+            SimSession session{ static_cast<uint32_t>(history.cycles.size()), 0, 0 };
+            for (int c = cyclesPerSession(rng); c > 0; --c) {
+                SimCycle cycle;
+                cycle.focusSeconds = static_cast<int32_t>(std::min(240.0, focus(rng)) * 60);
+                cycle.breakSeconds = breakMinutes(rng) * 60;
+                cycle.hyperfocus = cycle.focusSeconds > 60 * 60 && unit(rng) < 0.5;
+                double r = unit(rng);
+                cycle.rating = r < 0.4 ? Rating::Good : r < 0.75 ? Rating::Okay : Rating::Bad;
+                history.cycles.push_back(cycle);
+                session.cycleCount++;
+                session.lengthSeconds += cycle.focusSeconds + cycle.breakSeconds;
+            }
+            history.sessions.push_back(session);
+        }
+    }
+    return history;
+}
+
+bool parseRange(const std::string& value, int& lo, int& hi) {
+    size_t dash = value.find('-');
+    if (!parseOptionValue(value.substr(0, dash), lo)) return false;
+    hi = lo;
+    if (dash != std::string::npos && !parseOptionValue(value.substr(dash + 1), hi)) return false;
+    return lo >= 1 && hi >= lo && hi <= 600;
+}
+
+void printResultHeader() {
+    std::cout << "focus  rest  score  focus/day  on plan  rest/day  idle/day  hyperfocus  abandoned\n";
+}
+
+void printResult(const SimResult& result, const char* note) {
+    std::cout << std::setw(5) << result.focusMinutes << std::setw(6) << result.restMinutes << std::fixed
+              << std::setprecision(1) << std::setw(7) << result.score << std::setw(11) << result.focusPerDay
+              << std::setw(9) << result.onPlanPerDay << std::setw(10) << result.restPerDay
+              << std::setw(10) << result.idlePerDay << std::setw(11) << result.hyperfocusShare * 100 << "%"
+              << std::setw(10) << result.abandonedShare * 100 << "%" << note << "\n";
+}
+
+int runSimulateBench(int years, int grid, unsigned threads) {
+    SimHistory history = syntheticHistory(years);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SimResult> results = simulateGrid(history, 1, grid, 1, grid, threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << grid << "x" << grid << " grid over " << years << " year(s): " << history.sessions.size()
+              << " sessions, " << history.cycles.size() << " cycles per setting\n"
+              << std::fixed << std::setprecision(2) << seconds << " s on " << threads << " thread(s), "
+              << std::setprecision(1) << results.size() * history.cycles.size() / seconds / 1e6
+              << " M cycles/s" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+bool loadSimHistory(const std::string& logPath, int64_t from, int64_t to, SimHistory& history) {
+    history = SimHistory();
+    HistoryBuilder builder(history);
+    bool ok = forEachHistoryRecord(logPath, from != 0 ? from : INT64_MIN, to != 0 ? to : INT64_MAX,
+                                   [&builder](const LogRecord& record, uint64_t) { builder.add(record); });
+    if (!ok) {
+        std::cerr << "Error: Could not open " << logPath << std::endl;
+        return false;
+    }
+    builder.finishSession();
+    if (history.cycles.empty()) return true;
+
+    history.to = to != 0 ? to : builder.lastCycleEnd();
+    history.from = from;
+    if (from == 0) {
+        history.from = history.to - 365 * secondsPerDay;
+        builder.trimBefore(history.from);
+    }
+    history.days = static_cast<int>(std::max<int64_t>(1, (history.to - history.from + secondsPerDay - 1) / secondsPerDay));
+    return true;
+}
+
+SimResult simulate(const SimHistory& history, int focusMinutes, int restMinutes) {
+    SessionLogger logger("");   // replayed transitions are not logged
+    PomodoroManager timer(logger, focusMinutes, restMinutes);
+    Totals totals;
+    for (const SimSession& session : history.sessions) {
+        replaySession(timer, history.cycles.data() + session.firstCycle, session.cycleCount, session.lengthSeconds,
+                      totals);
+    }
+
+    SimResult result;
+    result.focusMinutes = focusMinutes;
+    result.restMinutes = restMinutes;
+    double days = std::max(1, history.days);
+    result.focusPerDay = totals.focus / 60.0 / days;
+    result.onPlanPerDay = totals.onPlan / 60.0 / days;
+    result.restPerDay = totals.rest / 60.0 / days;
+    result.idlePerDay = totals.idle / 60.0 / days;
+    result.hyperfocusShare = totals.completed > 0 ? static_cast<double>(totals.hyperfocus) / totals.completed : 0;
+    result.abandonedShare = totals.cycles > 0 ? static_cast<double>(totals.abandoned) / totals.cycles : 0;
+    result.score = result.onPlanPerDay - result.idlePerDay;
+    result.cycles = totals.cycles;
+    return result;
+}
+
+std::vector<SimResult> simulateGrid(const SimHistory& history, int focusLo, int focusHi, int restLo, int restHi,
+                                    unsigned threads) {
+    const int restCount = restHi - restLo + 1;
+    const size_t points = static_cast<size_t>(focusHi - focusLo + 1) * restCount;
+    std::vector<SimResult> results(points);
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < points; i = next++) {
+            results[i] = simulate(history, focusLo + static_cast<int>(i / restCount),
+                                  restLo + static_cast<int>(i % restCount));
+        }
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(points)));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& thread : pool) thread.join();
+    return results;
+}
+
+int runSimulateCommand(int argc, char* argv[]) {
+    const char* usage =
+        "Usage: ADHDPomodoro-CLI simulate [focus=5-60] [rest=1-30] [from=YYYY-MM-DD] [to=YYYY-MM-DD] "
+        "[threads=N] [top=10] [--csv]\n"
+        "       ADHDPomodoro-CLI simulate bench [years=1] [grid=100] [threads=N]";
+    int focusLo = 5, focusHi = 60, restLo = 1, restHi = 30;
+    int64_t from = 0, to = 0;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t top = 10;
+    int years = 1, grid = 100;
+    bool csv = false;
+    bool bench = argc > 2 && std::string(argv[2]) == "bench";
+
+    for (int i = bench ? 3 : 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = eq == std::string::npos ? arg : arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        bool valid = true;
+        if (arg == "--csv" && !bench) {
+            csv = true;
+        } else if (key == "focus" && !bench) {
+            valid = parseRange(value, focusLo, focusHi);
+        } else if (key == "rest" && !bench) {
+            valid = parseRange(value, restLo, restHi);
+        } else if ((key == "from" || key == "to") && !bench) {
+            valid = parseEpoch(value.data(), value.size(), key == "from" ? from : to);
+        } else if (key == "threads" && parseOptionValue(value, threads)) {
+            threads = std::max(1u, threads);
+        } else if (key == "top" && !bench && parseOptionValue(value, top)) {
+            top = std::max<size_t>(1, top);
+        } else if (key == "years" && bench && parseOptionValue(value, years)) {
+            years = std::max(1, years);
+        } else if (key == "grid" && bench && parseOptionValue(value, grid)) {
+            grid = std::max(1, grid);
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+    if (bench) {
+        return runSimulateBench(years, grid, threads);
+    }
+    // to= includes that day, as in query, export-ics and /sessions
+    if (to != 0) to = (static_cast<int64_t>(epochDay(to)) + 1) * secondsPerDay;
+
+    SimHistory history;
+    if (!loadSimHistory("log.txt", from, to, history)) return 1;
+    if (history.cycles.empty()) {
+        std::cout << "No focus sessions to replay" << std::endl;
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SimResult> results = simulateGrid(history, focusLo, focusHi, restLo, restHi, threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (csv) {
+        std::cout << "focus,rest,score,focus_per_day,on_plan_per_day,rest_per_day,idle_per_day,hyperfocus_share,"
+                     "abandoned_share\n";
+        for (const SimResult& r : results) {
+            std::cout << r.focusMinutes << "," << r.restMinutes << "," << r.score << "," << r.focusPerDay << ","
+                      << r.onPlanPerDay << "," << r.restPerDay << "," << r.idlePerDay << "," << r.hyperfocusShare << ","
+                      << r.abandonedShare << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << "Replayed " << history.sessions.size() << " sessions (" << history.cycles.size() << " cycles, "
+              << formatEpoch(history.from).substr(0, 10) << " to " << formatEpoch(history.to - 1).substr(0, 10)
+              << ") under " << results.size() << " settings in " << std::fixed << std::setprecision(2) << seconds
+              << " s\n\n";
+
+    CLISettings settings(false);
+    SimResult current = simulate(history, settings.getFocusDuration(), settings.getRestDuration());
+
+    // Highest score first (see Simulator.h); fewer abandoned cycles break ties
+    std::vector<SimResult> ranked = results;
+    std::sort(ranked.begin(), ranked.end(), [](const SimResult& a, const SimResult& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.abandonedShare < b.abandonedShare;
+    });
+    ranked.resize(std::min(top, ranked.size()));
+    printResultHeader();
+    for (const SimResult& result : ranked) {
+        bool isCurrent = result.focusMinutes == current.focusMinutes && result.restMinutes == current.restMinutes;
+        printResult(result, isCurrent ? "  (current)" : "");
+    }
+    std::cout << "\nCurrent settings:\n";
+    printResultHeader();
+    printResult(current, "");
+    return 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * What-if replay of the session history under other focus/rest durations.
+ *
+ * The log is reduced to focus cycles: how long the user actually focused
+ * (Focus/Hyperfocus minutes), the rating, and how long the following break
+ * lasted before the next cycle of the same session. Each grid point feeds
+ * these cycles through its own PomodoroManager on a virtual clock:
+ * - a cycle shorter than the focus duration ends before the bell and is
+ *   counted as abandoned, its break is untimed (idle);
+ * - otherwise the bell moves the timer to ExtendedFocus (or Hyperfocus if
+ *   the user went into hyperfocus) and the cycle is rated at its end;
+ * - a rest shorter than the rest duration is stretched to it, a longer one
+ *   counts the excess as idle time;
+ * - a session keeps its historical length, so cycles that no longer fit
+ *   are dropped.
+ * Grid points are independent and run in parallel.
+ *
+ * Settings are ranked by score = on-plan focus - idle, in minutes per day.
+ * On-plan focus counts only the focus minutes up to the bell of cycles that
+ * reach it, so an abandoned cycle scores nothing and a bell long before
+ * attention runs out gives away the overrun; idle is time neither focused
+ * nor resting as scheduled. Total focus is almost the same under every
+ * setting (it is what the user actually did), so it is not a useful rank.
+ */
+
+struct SimCycle {
+    int32_t focusSeconds;
+    int32_t breakSeconds;       // until the next cycle of the session (or logged rest + idle)
+    Rating rating;
+    bool hyperfocus;
+};
+
+struct SimSession {
+    uint32_t firstCycle;
+    uint32_t cycleCount;
+    int64_t lengthSeconds;      // first focus start to the end of the last break
+};
+
+struct SimHistory {
+    std::vector<SimCycle> cycles;
+    std::vector<SimSession> sessions;
+    int64_t from = 0;
+    int64_t to = 0;
+    int days = 0;               // calendar days in [from, to), the divisor of the per-day results
+};
+
+struct SimResult {
+    int focusMinutes = 0;
+    int restMinutes = 0;
+    double focusPerDay = 0;     // minutes
+    double onPlanPerDay = 0;    // focus up to the bell of completed cycles
+    double restPerDay = 0;
+    double idlePerDay = 0;
+    double hyperfocusShare = 0; // of completed cycles
+    double abandonedShare = 0;  // of cycles started
+    double score = 0;           // onPlanPerDay - idlePerDay
+    uint32_t cycles = 0;
+};
+
+// Reduce the records in [from, to) to cycles; from = 0 takes the last 365 days of the log
+bool loadSimHistory(const std::string& logPath, int64_t from, int64_t to, SimHistory& history);
+
+SimResult simulate(const SimHistory& history, int focusMinutes, int restMinutes);
+
+// Every (focus, rest) pair of the grid, in row-major order of focus
+std::vector<SimResult> simulateGrid(const SimHistory& history, int focusLo, int focusHi, int restLo, int restHi,
+                                    unsigned threads);
+
+// "ADHDPomodoro-CLI simulate [focus=LO-HI] [rest=LO-HI] [from=..] [to=..] [threads=N] [top=N] [--csv]"
+int runSimulateCommand(int argc, char* argv[]);
@@ -0,0 +1,229 @@
+#include "TagTable.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "LogArchive.h"
+
+TagTable::TagTable(const std::string& path) : tagsFilePath(path) {
+    names.emplace_back();
+    loadTags();
+}
+
+void TagTable::loadTags() {
+    std::ifstream tagsFile(tagsFilePath);
+    if (!tagsFile.is_open()) {
+        return;
+    }
+    std::string line;
+    while (std::getline(tagsFile, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        ids.emplace(line, static_cast<uint32_t>(names.size()));
+        names.push_back(line);
+    }
+}
+
+uint32_t TagTable::intern(const std::string& name) {
+    if (name.empty()) return 0;
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+
+    std::ofstream tagsFile(tagsFilePath, std::ios::app);
+    if (tagsFile.is_open()) {
+        tagsFile << name << "\n";
+    } else {
+        std::cerr << "Error: Could not save tags file" << std::endl;
+    }
+    return id;
+}
+
+uint32_t TagTable::find(const std::string& name) const {
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : 0;
+}
+
+const std::string& TagTable::name(uint32_t id) const {
+    static const std::string unknown = "?";
+    return id < names.size() ? names[id] : unknown;
+}
+
+TagStats::TagStats(const std::string& path, const std::string& logPath)
+    : statsFilePath(path), logFilePath(logPath) {
+    loadStats();
+}
+
+uint32_t TagStats::row(uint32_t rowMonth, uint32_t rowTag) {
+    uint64_t key = (static_cast<uint64_t>(rowMonth) << 32) | rowTag;
+    auto it = rowIndex.find(key);
+    if (it != rowIndex.end()) return it->second;
+
+    uint32_t index = static_cast<uint32_t>(month.size());
+    month.push_back(rowMonth);
+    tag.push_back(rowTag);
+    focusMinutes.push_back(0);
+    hyperfocusMinutes.push_back(0);
+    goodCount.push_back(0);
+    badCount.push_back(0);
+    okayCount.push_back(0);
+    rowIndex.emplace(key, index);
+    return index;
+}
+
+void TagStats::clear() {
+    month.clear();
+    tag.clear();
+    focusMinutes.clear();
+    hyperfocusMinutes.clear();
+    goodCount.clear();
+    badCount.clear();
+    okayCount.clear();
+    rowIndex.clear();
+}
+
+void TagStats::add(const LogRecord& record) {
+    if (record.event != LogEvent::Focus && record.event != LogEvent::Hyperfocus) return;
+
+    uint32_t index = row(epochMonth(record.timestamp), record.tagId);
+    if (record.event == LogEvent::Hyperfocus) {
+        hyperfocusMinutes[index] += record.value;
+        return;
+    }
+    focusMinutes[index] += record.value;
+    switch (record.rating) {
+        case Rating::Good: goodCount[index]++; break;
+        case Rating::Bad: badCount[index]++; break;
+        case Rating::Okay: okayCount[index]++; break;
+        default: break;
+    }
+}
+
+void TagStats::loadStats() {
+    std::ifstream statsFile(statsFilePath);
+    if (!statsFile.is_open()) {
+        return;
+    }
+    uint32_t m, t, focus, hyper, good, bad, okay;
+    while (statsFile >> m >> t >> focus >> hyper >> good >> bad >> okay) {
+        uint32_t index = row(m, t);
+        focusMinutes[index] = focus;
+        hyperfocusMinutes[index] = hyper;
+        goodCount[index] = good;
+        badCount[index] = bad;
+        okayCount[index] = okay;
+    }
+}
+
+void TagStats::save() const {
+    std::ofstream statsFile(statsFilePath);
+    if (!statsFile.is_open()) {
+        std::cerr << "Error: Could not save tag statistics" << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < month.size(); ++i) {
+        statsFile << month[i] << " " << tag[i] << " " << focusMinutes[i] << " " << hyperfocusMinutes[i]
+                  << " " << goodCount[i] << " " << badCount[i] << " " << okayCount[i] << "\n";
+    }
+}
+
+bool TagStats::backfill() {
+    if (statsFilePath.empty()) return false;
+    std::error_code error;
+    if (std::filesystem::exists(statsFilePath, error)) return false;
+    rebuild(logFilePath);
+    save();
+    return true;
+}
+
+void TagStats::rebuild(const std::string& logPath) {
+    clear();
+    forEachHistoryRecord(logPath, [this](const LogRecord& record) { add(record); });
+}
+
+std::vector<TagStats::Totals> TagStats::totalsByTag(uint32_t fromMonth, uint32_t toMonth) const {
+    std::vector<Totals> totals;
+    for (size_t i = 0; i < month.size(); ++i) {
+        if (month[i] < fromMonth || month[i] > toMonth) continue;
+        if (tag[i] >= totals.size()) totals.resize(tag[i] + 1);
+        Totals& t = totals[tag[i]];
+        t.focusMinutes += focusMinutes[i];
+        t.hyperfocusMinutes += hyperfocusMinutes[i];
+        t.good += goodCount[i];
+        t.bad += badCount[i];
+        t.okay += okayCount[i];
+    }
+    return totals;
+}
+
+namespace {
+
+bool parseMonthArg(const std::string& text, uint32_t& out) {
+    int64_t epoch;
+    std::string day = text + "-01";
+    if (text.size() != 7 || !parseEpoch(day.data(), day.size(), epoch)) return false;
+    out = epochMonth(epoch);
+    return true;
+}
+
+} // namespace
+
+int runTagsCommand(int argc, char* argv[]) {
+    uint32_t fromMonth = epochMonth(localNow());
+    uint32_t toMonth = fromMonth;
+    bool rebuild = false;
+    int monthArgs = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        uint32_t parsed;
+        if (arg == "--rebuild") {
+            rebuild = true;
+        } else if (arg == "--all") {
+            fromMonth = 0;
+            toMonth = UINT32_MAX;
+        } else if (parseMonthArg(arg, parsed)) {
+            if (monthArgs++ == 0) fromMonth = parsed;
+            toMonth = parsed;
+        } else {
+            std::cerr << "Usage: ADHDPomodoro-CLI tags [--all | YYYY-MM [YYYY-MM]] [--rebuild]" << std::endl;
+            return 1;
+        }
+    }
+
+    TagTable tags;
+    TagStats stats;
+    if (rebuild) {
+        stats.rebuild("log.txt");
+        stats.save();
+    } else if (stats.backfill()) {
+        std::cout << "Tag statistics built from log.txt\n";
+    }
+
+    std::vector<TagStats::Totals> totals = stats.totalsByTag(fromMonth, toMonth);
+    std::vector<uint32_t> order;
+    for (uint32_t id = 0; id < totals.size(); ++id) {
+        if (totals[id].focusMinutes + totals[id].hyperfocusMinutes > 0) order.push_back(id);
+    }
+    std::sort(order.begin(), order.end(), [&totals](uint32_t a, uint32_t b) {
+        return totals[a].focusMinutes + totals[a].hyperfocusMinutes >
+               totals[b].focusMinutes + totals[b].hyperfocusMinutes;
+    });
+
+    std::cout << std::left << std::setw(20) << "Tag" << std::right
+              << std::setw(8) << "Focus" << std::setw(8) << "Hyper"
+              << std::setw(6) << "Good" << std::setw(6) << "Bad" << std::setw(6) << "Okay" << "\n";
+    for (uint32_t id : order) {
+        const TagStats::Totals& t = totals[id];
+        std::cout << std::left << std::setw(20) << (id == 0 ? "(untagged)" : tags.name(id)) << std::right
+                  << std::setw(8) << t.focusMinutes << std::setw(8) << t.hyperfocusMinutes
+                  << std::setw(6) << t.good << std::setw(6) << t.bad << std::setw(6) << t.okay << "\n";
+    }
+    if (order.empty()) {
+        std::cout << "No focus sessions recorded in this period\n";
+    }
+    return 0;
+}
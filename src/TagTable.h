@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * Interned tag names. Each distinct tag is stored once in tags.txt
+ * (line N holds the name of tag id N) and referenced by id in log records.
+ * Id 0 is reserved for untagged sessions.
+ */
+class TagTable {
+public:
+    explicit TagTable(const std::string& path = "tags.txt");
+
+    // Returns the id of an existing tag or appends a new one; empty names map to 0
+    uint32_t intern(const std::string& name);
+    // Returns 0 if the tag is unknown
+    uint32_t find(const std::string& name) const;
+    const std::string& name(uint32_t id) const;
+    uint32_t size() const { return static_cast<uint32_t>(names.size()); }
+
+private:
+    std::string tagsFilePath;
+    std::vector<std::string> names;                 // index = tag id, names[0] = ""
+    std::unordered_map<std::string, uint32_t> ids;
+
+    void loadTags();
+};
+
+/**
+ * Per-tag focus totals and rating counts, one row per (month, tag) pair,
+ * stored as parallel columns so that reports scan only the columns they need.
+ */
+class TagStats {
+public:
+    explicit TagStats(const std::string& path = "tagstats.txt", const std::string& logPath = "log.txt");
+
+    // Fold a log record into the aggregates (listener for SessionLogger)
+    void add(const LogRecord& record);
+    // Rebuild and save from the whole history if the file is missing, so minutes
+    // logged before it existed are counted; returns true if it rebuilt
+    bool backfill();
+    void save() const;
+    // Recompute all rows from a log file
+    void rebuild(const std::string& logPath);
+
+    struct Totals {
+        uint32_t focusMinutes = 0;
+        uint32_t hyperfocusMinutes = 0;
+        uint32_t good = 0;
+        uint32_t bad = 0;
+        uint32_t okay = 0;
+    };
+    // Sum per tag id over the months in [fromMonth, toMonth] (YYYYMM)
+    std::vector<Totals> totalsByTag(uint32_t fromMonth, uint32_t toMonth) const;
+
+private:
+    std::string statsFilePath;
+    std::string logFilePath;
+
+    // Columns
+    std::vector<uint32_t> month;                    // YYYYMM
+    std::vector<uint32_t> tag;
+    std::vector<uint32_t> focusMinutes;
+    std::vector<uint32_t> hyperfocusMinutes;
+    std::vector<uint32_t> goodCount;
+    std::vector<uint32_t> badCount;
+    std::vector<uint32_t> okayCount;
+
+    std::unordered_map<uint64_t, uint32_t> rowIndex; // (month << 32 | tag) -> row
+
+    uint32_t row(uint32_t rowMonth, uint32_t rowTag);
+    void clear();
+    void loadStats();
+};
+
+// "ADHDPomodoro-CLI tags [YYYY-MM [YYYY-MM]]"
+int runTagsCommand(int argc, char* argv[]);
@@ -0,0 +1,283 @@
+#include "TimelineWindow.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const unsigned windowWidth = 360;
+const unsigned windowHeight = 400;
+const float rowHeight = 20.f;
+const size_t visibleRows = static_cast<size_t>(windowHeight / rowHeight) + 1;
+const size_t cacheSize = 64;   // power of two, larger than visibleRows
+const float scrollbarWidth = 6.f;
+
+sf::Color markerColor(const LogRecord& record) {
+    if (record.event == LogEvent::Hyperfocus) return sf::Color(140, 80, 200);
+    switch (record.rating) {
+        case Rating::Good: return sf::Color(60, 170, 80);
+        case Rating::Okay: return sf::Color(230, 190, 50);
+        case Rating::Bad: return sf::Color(210, 70, 60);
+        default: return sf::Color(150, 150, 150);
+    }
+}
+
+void setQuad(sf::Vertex* quad, float x, float y, float width, float height, const sf::Color& color) {
+    quad[0].position = sf::Vector2f(x, y);
+    quad[1].position = sf::Vector2f(x + width, y);
+    quad[2].position = sf::Vector2f(x + width, y + height);
+    quad[3].position = sf::Vector2f(x, y + height);
+    for (int corner = 0; corner < 4; ++corner) {
+        quad[corner].color = color;
+    }
+}
+
+} // namespace
+
+TimelineWindow::TimelineWindow(SessionIndex& index, const TagTable& tags)
+    : index(index), tags(tags), rowTexts(visibleRows), quads(sf::Quads, (visibleRows * 2 + 1) * 4),
+      firstRow(0), rowOffset(0.f), shownCount(0), cache(cacheSize), blockTotal(0), wantedFirst(0), ready(false),
+      refreshPending(false), stopping(false) {
+    worker = std::thread(&TimelineWindow::run, this);
+}
+
+TimelineWindow::~TimelineWindow() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void TimelineWindow::toggle() {
+    if (window) {
+        window->close();
+        window.reset();
+        return;
+    }
+    window = std::make_unique<sf::RenderWindow>(
+        sf::VideoMode(windowWidth, windowHeight),
+        "Session Timeline",
+        sf::Style::Titlebar | sf::Style::Close
+    );
+    firstRow = 0;
+    rowOffset = 0.f;
+    refresh();
+}
+
+void TimelineWindow::refresh() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        refreshPending = true;
+    }
+    wake.notify_one();
+}
+
+void TimelineWindow::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (refreshPending) {
+            refreshPending = false;
+            lock.unlock();
+            index.update();
+            const uint32_t count = index.blockCount();
+            lock.lock();
+            // New sessions shift every row by one; drop the cached rows
+            if (count != blockTotal) {
+                blockTotal = count;
+                for (CachedRow& entry : cache) entry.row = UINT32_MAX;
+            }
+            ready = true;
+            continue;
+        }
+
+        std::vector<uint32_t> missing;
+        for (uint32_t row = wantedFirst; row < wantedFirst + visibleRows && row < blockTotal; ++row) {
+            if (cache[row & (cacheSize - 1)].row != row) missing.push_back(row);
+        }
+        if (missing.empty()) {
+            wake.wait(lock);
+            continue;
+        }
+
+        // Row 0 is the newest session
+        const uint32_t count = blockTotal;
+        lock.unlock();
+        std::vector<CachedRow> rows(missing.size());
+        for (size_t i = 0; i < missing.size(); ++i) {
+            CachedRow& entry = rows[i];
+            entry.row = missing[i];
+            entry.marker = sf::Color(150, 150, 150);
+            LogRecord record;
+            if (!index.readBlock(count - 1 - entry.row, record)) {
+                entry.text = "(unreadable record)";
+                continue;
+            }
+            const int64_t start = record.timestamp - static_cast<int64_t>(record.value) * 60;
+            entry.text = formatEpoch(start).substr(0, 16) + "  " + std::to_string(record.value) + " min  " +
+                         (record.event == LogEvent::Hyperfocus ? "Hyperfocus" : ratingName(record.rating));
+            entry.tagId = record.tagId;
+            entry.marker = markerColor(record);
+        }
+        lock.lock();
+        if (count == blockTotal) {
+            for (CachedRow& entry : rows) cache[entry.row & (cacheSize - 1)] = std::move(entry);
+        }
+    }
+}
+
+void TimelineWindow::maxScroll(uint32_t& row, float& offset) const {
+    const uint32_t fullRows = static_cast<uint32_t>(windowHeight / rowHeight);
+    const float partial = static_cast<float>(windowHeight) - static_cast<float>(fullRows) * rowHeight;
+    const uint32_t spanned = fullRows + (partial > 0.f ? 1 : 0);
+    if (shownCount < spanned) {
+        row = 0;
+        offset = 0.f;
+        return;
+    }
+    // The last full rows fill the bottom, the row above them shows only its lower part
+    row = shownCount - spanned;
+    offset = partial > 0.f ? rowHeight - partial : 0.f;
+}
+
+void TimelineWindow::scrollBy(float pixels) {
+    // Whole rows move the row index; only the remainder stays in pixels
+    const double moved = static_cast<double>(rowOffset) + pixels;
+    const double rows = std::floor(moved / rowHeight);
+    int64_t row = static_cast<int64_t>(firstRow) + static_cast<int64_t>(rows);
+    float offset = static_cast<float>(moved - rows * rowHeight);
+    if (offset >= rowHeight) {
+        ++row;
+        offset = 0.f;
+    }
+
+    uint32_t lastRow;
+    float lastOffset;
+    maxScroll(lastRow, lastOffset);
+    if (row < 0) {
+        row = 0;
+        offset = 0.f;
+    }
+    if (row > lastRow || (row == lastRow && offset > lastOffset)) {
+        row = lastRow;
+        offset = lastOffset;
+    }
+    firstRow = static_cast<uint32_t>(row);
+    rowOffset = offset;
+}
+
+void TimelineWindow::handleEvents() {
+    if (!window) return;
+
+    sf::Event event;
+    while (window && window->pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            toggle();
+        } else if (event.type == sf::Event::MouseWheelScrolled) {
+            scrollBy(-event.mouseWheelScroll.delta * rowHeight * 3.f);
+        } else if (event.type == sf::Event::KeyPressed) {
+            switch (event.key.code) {
+                case sf::Keyboard::Up: scrollBy(-rowHeight); break;
+                case sf::Keyboard::Down: scrollBy(rowHeight); break;
+                case sf::Keyboard::PageUp: scrollBy(-static_cast<float>(windowHeight)); break;
+                case sf::Keyboard::PageDown: scrollBy(static_cast<float>(windowHeight)); break;
+                case sf::Keyboard::Home:
+                    firstRow = 0;
+                    rowOffset = 0.f;
+                    break;
+                case sf::Keyboard::End: maxScroll(firstRow, rowOffset); break;
+                default: break;
+            }
+        }
+    }
+}
+
+void TimelineWindow::draw(const sf::Font& font) {
+    if (!window) return;
+
+    if (statusText.getFont() == nullptr) {
+        statusText.setFont(font);
+        statusText.setCharacterSize(13);
+        statusText.setFillColor(sf::Color(120, 120, 120));
+        statusText.setPosition(14, 8);
+    }
+
+    bool needRows = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ready) {
+            statusText.setString("Loading sessions...");
+            window->clear(sf::Color::White);
+            window->draw(statusText);
+            window->display();
+            return;
+        }
+        if (blockTotal != shownCount) {
+            shownCount = blockTotal;
+            scrollBy(0.f);
+        }
+
+        const float firstY = -rowOffset;
+        if (firstRow != wantedFirst) {
+            wantedFirst = firstRow;
+            needRows = true;
+        }
+
+        for (size_t i = 0; i < visibleRows; ++i) {
+            const uint32_t row = firstRow + static_cast<uint32_t>(i);
+            const float y = firstY + static_cast<float>(i) * rowHeight;
+            sf::Vertex* stripe = &quads[i * 8];
+            sf::Vertex* marker = &quads[i * 8 + 4];
+            sf::Text& text = rowTexts[i];
+
+            if (row >= shownCount) {
+                setQuad(stripe, 0, 0, 0, 0, sf::Color::Transparent);
+                setQuad(marker, 0, 0, 0, 0, sf::Color::Transparent);
+                text.setString("");
+                continue;
+            }
+
+            // Rows the worker has not read yet are drawn empty
+            const CachedRow& entry = cache[row & (cacheSize - 1)];
+            const bool cached = entry.row == row;
+            needRows = needRows || !cached;
+            setQuad(stripe, 0, y, windowWidth - scrollbarWidth, rowHeight,
+                    row % 2 ? sf::Color(245, 245, 245) : sf::Color::White);
+            setQuad(marker, 4, y + 4, 4, rowHeight - 8, cached ? entry.marker : sf::Color(220, 220, 220));
+            if (text.getFont() == nullptr) {
+                text.setFont(font);
+                text.setCharacterSize(13);
+                text.setFillColor(sf::Color(50, 50, 50));
+            }
+            if (!cached) {
+                text.setString("");
+            } else if (entry.tagId != 0) {
+                text.setString(entry.text + "  " + tags.name(entry.tagId));
+            } else {
+                text.setString(entry.text);
+            }
+            text.setPosition(14, y + 2);
+        }
+    }
+    if (needRows) wake.notify_one();
+
+    // Scrollbar thumb, in double: the content can be hundreds of millions of pixels tall
+    sf::Vertex* thumb = &quads[visibleRows * 8];
+    uint32_t lastRow;
+    float lastOffset;
+    maxScroll(lastRow, lastOffset);
+    const double content = std::max(static_cast<double>(shownCount) * rowHeight, static_cast<double>(windowHeight));
+    const double thumbHeight = std::max(20.0, windowHeight * static_cast<double>(windowHeight) / content);
+    const double range = static_cast<double>(lastRow) * rowHeight + lastOffset;
+    const double position = static_cast<double>(firstRow) * rowHeight + rowOffset;
+    const float thumbY = range > 0 ? static_cast<float>((windowHeight - thumbHeight) * position / range) : 0.f;
+    setQuad(thumb, windowWidth - scrollbarWidth, thumbY, scrollbarWidth, static_cast<float>(thumbHeight),
+            sf::Color(180, 180, 180));
+
+    window->clear(sf::Color::White);
+    window->draw(quads);
+    for (const sf::Text& text : rowTexts) {
+        window->draw(text);
+    }
+    window->display();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "SessionIndex.h"
+#include "TagTable.h"
+
+/**
+ * Scrollable list of past Focus/Hyperfocus sessions, newest first, in its
+ * own window (opened from the "Timeline" menu item).
+ *
+ * A worker thread owns the session index: it brings the index up to date
+ * (a full build the first time) and reads the rows inside the viewport
+ * from its fixed-size block table into a fixed-size direct-mapped cache.
+ * The GUI thread only draws what the cache holds, with a placeholder until
+ * the index or a row is ready, so it never waits for disk and memory and
+ * frame time do not depend on how many sessions the history holds.
+ */
+class TimelineWindow {
+public:
+    TimelineWindow(SessionIndex& index, const TagTable& tags);
+    ~TimelineWindow();
+
+    TimelineWindow(const TimelineWindow&) = delete;
+    TimelineWindow& operator=(const TimelineWindow&) = delete;
+
+    void toggle();
+    bool isOpen() const { return window != nullptr; }
+
+    // Call when new sessions have been logged
+    void refresh();
+
+    void handleEvents();
+    void draw(const sf::Font& font);
+
+private:
+    struct CachedRow {
+        uint32_t row = UINT32_MAX;
+        std::string text;
+        uint32_t tagId = 0;
+        sf::Color marker;
+    };
+
+    SessionIndex& index;
+    const TagTable& tags;
+    std::unique_ptr<sf::RenderWindow> window;
+
+    std::vector<sf::Text> rowTexts;     // one per visible row
+    sf::Text statusText;
+    sf::VertexArray quads;              // row stripes, rating markers and scrollbar
+    // Scroll position as a row and pixels into it, so it stays exact however many rows there are
+    uint32_t firstRow;                  // topmost visible row, 0 = newest session
+    float rowOffset;                    // pixels of firstRow above the window, [0, rowHeight)
+    uint32_t shownCount;                // sessions as of the last frame
+
+    // Shared with the worker
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<CachedRow> cache;
+    uint32_t blockTotal;
+    uint32_t wantedFirst;               // first row of the viewport
+    bool ready;                         // index built
+    bool refreshPending;
+    bool stopping;
+    std::thread worker;
+
+    void run();
+    void scrollBy(float pixels);
+    // Furthest scroll position: the oldest session at the bottom of the window
+    void maxScroll(uint32_t& row, float& offset) const;
+};
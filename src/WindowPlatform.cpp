@@ -0,0 +1,91 @@
+#include "WindowPlatform.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#include <vector>
+#endif
+
+#if defined(_WIN32)
+
+bool setAlwaysOnTop(sf::WindowHandle handle, bool enabled) {
+    return SetWindowPos(handle, enabled ? HWND_TOPMOST : HWND_NOTOPMOST, 0, 0, 0, 0,
+                        SWP_NOMOVE | SWP_NOSIZE) != 0;
+}
+
+#elif defined(__linux__)
+
+namespace {
+
+// Before the window manager has mapped the window it reads the initial state from the property
+bool setStateProperty(Display* display, Window window, Atom state, Atom above, bool enabled) {
+    std::vector<Atom> atoms;
+    Atom type;
+    int format;
+    unsigned long count, remaining;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(display, window, state, 0, 64, False, XA_ATOM, &type, &format, &count, &remaining,
+                           &data) == Success && data) {
+        if (type == XA_ATOM && format == 32) {
+            const Atom* current = reinterpret_cast<const Atom*>(data);
+            for (unsigned long i = 0; i < count; ++i) {
+                if (current[i] != above) atoms.push_back(current[i]);
+            }
+        }
+        XFree(data);
+    }
+    if (enabled) atoms.push_back(above);
+    XChangeProperty(display, window, state, XA_ATOM, 32, PropModeReplace,
+                    reinterpret_cast<const unsigned char*>(atoms.data()), static_cast<int>(atoms.size()));
+    return true;
+}
+
+// Once mapped, the window manager owns the property and only acts on client messages
+bool sendStateMessage(Display* display, Window window, Atom state, Atom above, bool enabled) {
+    // EWMH: a _NET_WM_STATE client message to the root window, data = action, property, 0, source
+    XEvent event{};
+    event.xclient.type = ClientMessage;
+    event.xclient.window = window;
+    event.xclient.message_type = state;
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = enabled ? 1 : 0;     // _NET_WM_STATE_ADD / _NET_WM_STATE_REMOVE
+    event.xclient.data.l[1] = static_cast<long>(above);
+    event.xclient.data.l[2] = 0;
+    event.xclient.data.l[3] = 1;                   // normal application
+
+    return XSendEvent(display, DefaultRootWindow(display), False,
+                      SubstructureRedirectMask | SubstructureNotifyMask, &event) != 0;
+}
+
+} // namespace
+
+bool setAlwaysOnTop(sf::WindowHandle handle, bool enabled) {
+    // SFML keeps its display connection private; any connection can ask the window manager
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return false;
+    }
+
+    const Window window = static_cast<Window>(handle);
+    const Atom state = XInternAtom(display, "_NET_WM_STATE", False);
+    const Atom above = XInternAtom(display, "_NET_WM_STATE_ABOVE", False);
+    XWindowAttributes attributes;
+    bool applied = false;
+    if (XGetWindowAttributes(display, window, &attributes)) {
+        applied = attributes.map_state == IsUnmapped ? setStateProperty(display, window, state, above, enabled)
+                                                     : sendStateMessage(display, window, state, above, enabled);
+    }
+    XFlush(display);
+    XCloseDisplay(display);
+    return applied;
+}
+
+#else
+
+bool setAlwaysOnTop(sf::WindowHandle, bool) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <SFML/Window/WindowHandle.hpp>
+
+/**
+ * Platform-specific window behavior the SFML API does not cover.
+ *
+ * Windows uses SetWindowPos, X11 asks the window manager through the
+ * EWMH _NET_WM_STATE_ABOVE hint; elsewhere the calls do nothing and
+ * return false. On X11 an unmapped window gets the hint as its initial
+ * _NET_WM_STATE; a mapped one gets a client message, which a window
+ * manager that has not taken the window over yet may drop, so call it
+ * again once the window has received its first event.
+ */
+
+// Keep the window above other windows (or release it again)
+bool setAlwaysOnTop(sf::WindowHandle handle, bool enabled = true);
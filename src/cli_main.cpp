@@ -1,4 +1,6 @@
+#include <cctype>
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <iomanip>
@@ -6,6 +8,18 @@
 #include <iostream>
 #include <thread>
 #include "CLISettings.h"
+#include "SessionLog.h"
+#include "SessionHistory.h"
+#include "LogMerge.h"
+#include "LogArchive.h"
+#include "IcsExport.h"
+#include "PomodoroManager.h"
+#include "HeadlessMode.h"
+#include "HttpServer.h"
+#include "BigTimerView.h"
+#include "BusyCalendar.h"
+#include "Simulator.h"
+#include "QualityModel.h"
 
 // Platform-specific includes for keyboard input
 #ifdef _WIN32
@@ -26,31 +40,40 @@
  * - Focus, ExtendedFocus, Rest, Hyperfocus, IdleAfterRest states
  * - Feedback system (Good/Bad/Okay/Hyperfocus ratings)
  * - Configurable durations via settings
- * - Session logging with timestamps
+ * - Session logging with timestamps and optional task tags
  * - Cross-platform keyboard input handling
+ *
+ * Subcommands:
+ *   ADHDPomodoro-CLI tags [--all | YYYY-MM [YYYY-MM]] [--rebuild]
+ *   ADHDPomodoro-CLI query [tag=..] [rating=..] [state=..] [from=..] [to=..] [--count]
+ *   ADHDPomodoro-CLI rollup rebuild | show [from=..] [to=..] [points=N] | bench [years=N]
+ *   ADHDPomodoro-CLI stats [--rebuild] [--merge FILE...] | stats bench [n=N]
+ *   ADHDPomodoro-CLI export-ics [--from YYYY-MM-DD] [--to YYYY-MM-DD] [-o FILE]
+ *   ADHDPomodoro-CLI merge a.txt b.txt ... -o merged.txt [--tags FILE]
+ *   ADHDPomodoro-CLI archive [status] | enable [size=MB] [monthly] | disable | rotate | compact | bench
+ *   ADHDPomodoro-CLI --headless [--log FILE]   (JSON lines on stdin/stdout)
+ *   ADHDPomodoro-CLI serve [port=N] | serve bench [connections=N] [seconds=N]
+ *   ADHDPomodoro-CLI bigclock bench [frames=N] [cols=N] [rows=N]
+ *   ADHDPomodoro-CLI calendar import FILE.ics | show [days=N] | clear | bench [events=N]
+ *   ADHDPomodoro-CLI simulate [focus=LO-HI] [rest=LO-HI] [from=..] [to=..] [--csv] | simulate bench
+ *   ADHDPomodoro-CLI model [show] [--rebuild] [tag=..] [focus=N] [rest=N] | model bench [samples=N]
+ *   ADHDPomodoro-CLI [--http [PORT]] [--big]    (timer with the local HTTP API / full-screen digits)
  */
 
-// Timer states
-enum class State {
-    Focus,
-    ExtendedFocus,
-    Rest,
-    Hyperfocus,
-    IdleAfterRest
-};
-
 // Forward declarations
 std::string formatTime(int seconds);
-std::string getTimestamp();
 void clearScreen();
 void displayTimer(State currentState, int elapsedSeconds, int totalFocusTime, 
-                 bool isTimerRunning, bool isPaused, const CLISettings& settings);
+                 bool isTimerRunning, bool isPaused, const CLISettings& settings,
+                 const std::string& tagName, int focusMinutes, const std::string& notice,
+                 const std::string& suggestion);
 #ifndef _WIN32
 bool kbhit();
 char getch();
 #endif
 void showHelp();
 void showSettings(CLISettings& settings);
+std::string promptTag();
 
 // Convert seconds to MM:SS format
 std::string formatTime(int seconds) {
@@ -62,14 +85,6 @@ std::string formatTime(int seconds) {
     return oss.str();
 }
 
-// Get current timestamp for logging
-std::string getTimestamp() {
-    auto now = std::time(nullptr);
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S");
-    return oss.str();
-}
-
 // Clear screen
 void clearScreen() {
 #ifdef _WIN32
@@ -131,6 +146,7 @@ void showHelp() {
     std::cout << "  f/F - Finish current session\n";
     std::cout << "  c/C - Show/Edit settings\n";
     std::cout << "  h/H - Show this help\n";
+    std::cout << "  v/V - Toggle full-screen big digits\n";
     std::cout << "  q/Q - Quit\n\n";
     std::cout << "During Extended Focus:\n";
     std::cout << "  g/G - Good session (go to rest)\n";
@@ -189,13 +205,34 @@ void showSettings(CLISettings& settings) {
     } while (true);
 }
 
+// Ask for the task the session is about (read as a whole line)
+std::string promptTag() {
+    std::cout << "\nTag for this session (Enter for none): " << std::flush;
+    std::string tag;
+    std::getline(std::cin, tag);
+    size_t first = tag.find_first_not_of(" \t\r");
+    size_t last = tag.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : tag.substr(first, last - first + 1);
+}
+
 void displayTimer(State currentState, int elapsedSeconds, int totalFocusTime, 
-                 bool isTimerRunning, bool isPaused, const CLISettings& settings) {
+                 bool isTimerRunning, bool isPaused, const CLISettings& settings,
+                 const std::string& tagName, int focusMinutes, const std::string& notice,
+                 const std::string& suggestion) {
     clearScreen();
     std::cout << "\n=== ADHD Pomodoro Timer - CLI Version ===\n\n";
+    if (isTimerRunning && !tagName.empty()) {
+        std::cout << "Tag: " << tagName << "\n";
+    }
+    if (!notice.empty()) {
+        std::cout << notice << "\n";
+    }
     
     if (!isTimerRunning) {
         std::cout << "Status: Ready to start\n";
+        if (!suggestion.empty()) {
+            std::cout << suggestion << "\n";
+        }
         std::cout << "Press 's' to start, 'h' for help, 'q' to quit\n";
     } else if (isPaused) {
         std::cout << "Status: PAUSED - " << formatTime(elapsedSeconds) << "\n";
@@ -203,7 +240,7 @@ void displayTimer(State currentState, int elapsedSeconds, int totalFocusTime,
     } else {
         switch (currentState) {
             case State::Focus: {
-                int remaining = settings.getFocusDuration() * 60 - elapsedSeconds;
+                int remaining = focusMinutes * 60 - elapsedSeconds;
                 std::cout << "Status: FOCUS - " << formatTime(remaining > 0 ? remaining : 0) << "\n";
                 if (remaining > 0) {
                     std::cout << "Stay focused! Press 'p' to pause, 'f' to finish\n";
@@ -242,71 +279,241 @@ void displayTimer(State currentState, int elapsedSeconds, int totalFocusTime,
     std::cout << "Press 'h' for help, 'c' for settings, 'q' to quit\n";
 }
 
-int main() {
+// Check the focus block about to start against the imported calendar: shorten it
+// to end before a meeting that is at least 5 minutes away, otherwise warn, and
+// suggest the next free Focus+Rest slot. Returns the notice to show ("" if clear).
+std::string planFocus(const BusyCalendar& calendar, PomodoroManager& timer, const CLISettings& settings) {
+    timer.setFocusDuration(settings.getFocusDuration());
+    if (calendar.size() == 0) return std::string();
+
+    int64_t now = localNow();
+    BusyCalendar::Interval busy;
+    if (!calendar.conflict(now, now + settings.getFocusDuration() * 60, busy)) return std::string();
+
+    std::string notice;
+    int64_t minutesUntil = (busy.start - now) / 60;
+    if (busy.start <= now) {
+        notice = "Calendar: busy until " + formatEpoch(busy.end).substr(11, 5);
+    } else if (minutesUntil >= 5) {
+        timer.setFocusDuration(static_cast<int>(minutesUntil));
+        notice = "Calendar: meeting at " + formatEpoch(busy.start).substr(11, 5) + ", focus shortened to " +
+                 std::to_string(minutesUntil) + " min";
+    } else {
+        notice = "Calendar: meeting at " + formatEpoch(busy.start).substr(11, 5);
+    }
+    int64_t slot = calendar.nextFreeSlot(now, (settings.getFocusDuration() + settings.getRestDuration()) * 60);
+    std::string slotText = formatEpoch(slot);
+    notice += "; next free Focus+Rest slot " +
+              (slotText.compare(0, 10, formatEpoch(now), 0, 10) == 0 ? slotText.substr(11, 5) : slotText.substr(0, 16));
+    return notice;
+}
+
+// The quality model's suggestion for a focus block starting now
+std::string suggestFocus(const QualityModel& model, uint32_t tagId, const CLISettings& settings) {
+    return formatSuggestion(model.suggest(localNow(), tagId, settings.getFocusDuration(), settings.getRestDuration()),
+                            settings.getFocusDuration(), settings.getRestDuration());
+}
+
+// Calendar notice and, once the model has enough ratings, its suggestion for the block about to start
+std::string focusNotice(const BusyCalendar& calendar, PomodoroManager& timer, const CLISettings& settings,
+                        const QualityModel& model, uint32_t tagId) {
+    std::string notice = planFocus(calendar, timer, settings);
+    if (model.getSamples() >= QualityModel::minimumSamples) {
+        notice += (notice.empty() ? "" : "; ") + suggestFocus(model, tagId, settings);
+    }
+    return notice;
+}
+
+// Copy the timer state to the board read by the HTTP thread
+void publishStatus(StatusBoard& board, const PomodoroManager& timer, const std::string& tagName) {
+    TimerStatus status;
+    status.available = true;
+    status.state = timer.getState();
+    status.running = timer.isRunning();
+    status.paused = timer.isPausedNow();
+    status.elapsedSeconds = timer.getElapsedSeconds();
+    status.totalFocusSeconds = timer.getTotalFocusTime();
+    status.focusMinutes = timer.getFocusDuration();
+    status.restMinutes = timer.getRestDuration();
+    if (status.state == State::Focus) status.remainingSeconds = status.focusMinutes * 60 - status.elapsedSeconds;
+    if (status.state == State::Rest) status.remainingSeconds = status.restMinutes * 60 - status.elapsedSeconds;
+    if (status.remainingSeconds < 0) status.remainingSeconds = 0;
+    std::snprintf(status.tag, sizeof(status.tag), "%s", timer.isRunning() ? tagName.c_str() : "");
+    board.publish(status);
+}
+
+// One frame of the full-screen view: phase name, big time, phase progress and key hints
+void renderBigTimer(BigTimerView& view, const PomodoroManager& timer, const std::string& tagName,
+                    const std::string& notice) {
+    const char* label = "READY";
+    const char* hint = "s start  h help  c settings  v normal view  q quit";
+    int seconds = timer.getFocusDuration() * 60;
+    double progress = 0;
+    if (timer.isRunning() && timer.isPausedNow()) {
+        label = "PAUSED";
+        hint = "p resume  f finish  v normal view  q quit";
+        seconds = timer.getElapsedSeconds();
+    } else if (timer.isRunning()) {
+        int elapsed = timer.getElapsedSeconds();
+        switch (timer.getState()) {
+            case State::Focus:
+                label = "FOCUS";
+                hint = "p pause  f finish  v normal view  q quit";
+                seconds = timer.getFocusDuration() * 60 - elapsed;
+                progress = static_cast<double>(elapsed) / (timer.getFocusDuration() * 60);
+                break;
+            case State::ExtendedFocus:
+                label = "EXTENDED FOCUS";
+                hint = "g good  b bad  o okay  h hyperfocus  v normal view";
+                seconds = timer.getTotalFocusTime();
+                progress = 1;
+                break;
+            case State::Hyperfocus:
+                label = "HYPERFOCUS";
+                hint = "r rest  v normal view  q quit";
+                seconds = timer.getTotalFocusTime();
+                progress = 1;
+                break;
+            case State::Rest:
+                label = "REST";
+                hint = "f focus now  v normal view  q quit";
+                seconds = timer.getRestDuration() * 60 - elapsed;
+                progress = static_cast<double>(elapsed) / (timer.getRestDuration() * 60);
+                break;
+            case State::IdleAfterRest:
+                label = "IDLE";
+                hint = "f start next focus  v normal view  q quit";
+                seconds = elapsed;
+                progress = 1;
+                break;
+        }
+    }
+    std::string caption = timer.isRunning() ? tagName : std::string();
+    if (!notice.empty()) caption += caption.empty() ? notice : "  " + notice;
+    view.render(label, seconds, progress, caption.c_str(), hint);
+}
+
+int main(int argc, char* argv[]) {
+    int httpPort = -1;
+    if (argc > 1) {
+        std::string command = argv[1];
+        if (command == "tags") {
+            return runTagsCommand(argc, argv);
+        }
+        if (command == "query") {
+            return runQueryCommand(argc, argv);
+        }
+        if (command == "rollup") {
+            return runRollupCommand(argc, argv);
+        }
+        if (command == "stats") {
+            return runStatsCommand(argc, argv);
+        }
+        if (command == "export-ics") {
+            return runExportIcsCommand(argc, argv);
+        }
+        if (command == "merge") {
+            return runMergeCommand(argc, argv);
+        }
+        if (command == "archive") {
+            return runArchiveCommand(argc, argv);
+        }
+        if (command == "--headless") {
+            return runHeadless(argc, argv);
+        }
+        if (command == "serve") {
+            return runServeCommand(argc, argv);
+        }
+        if (command == "bigclock") {
+            return runBigClockCommand(argc, argv);
+        }
+        if (command == "calendar") {
+            return runCalendarCommand(argc, argv);
+        }
+        if (command == "simulate") {
+            return runSimulateCommand(argc, argv);
+        }
+        if (command == "model") {
+            return runModelCommand(argc, argv);
+        }
+    }
+    // Options of the interactive timer
+    bool bigView = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--http") {
+            httpPort = 8765;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                httpPort = std::atoi(argv[++i]);
+            }
+        } else if (option == "--big") {
+            bigView = true;
+        } else {
+            std::cerr << "Unknown command: " << option << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "Starting ADHD Pomodoro Timer - CLI Version...\n";
     
     // Initialize settings
     CLISettings settings;
     
-    // Timer variables
-    using Clock = std::chrono::steady_clock;
-    using TimePoint = std::chrono::time_point<Clock>;
-    TimePoint startTime = Clock::now();
-    TimePoint pauseTime = Clock::now();
-    State currentState = State::Focus;
-    int elapsedSeconds = 0;
-    int totalFocusTime = 0;
-    bool isTimerRunning = false;
-    bool isPaused = false;
-    std::ofstream logFile("log.txt", std::ios::app);
+    // Session log with per-tag aggregates, the search index and time-series rollups
+    SessionLogger logger;
+    SessionHistory history;
+    history.attach(logger);
+    // Log rotation (rotation.txt) and background compaction of sealed segments
+    LogArchiver archiver;
+    archiver.attach(logger);
+    
+    // Timer state machine
+    using Clock = PomodoroManager::Clock;
+    PomodoroManager timer(logger, settings.getFocusDuration(), settings.getRestDuration());
+    
+    // Optional local HTTP API, served from its own thread
+    StatusBoard statusBoard;
+    HttpServer httpServer(statusBoard);
+    if (httpPort >= 0 && httpServer.start(static_cast<uint16_t>(httpPort))) {
+        std::cout << "HTTP API on http://127.0.0.1:" << httpServer.getPort() << "\n";
+    }
+    
+    // Busy periods imported with "calendar import" and the quality model's
+    // suggestion, checked at each focus start
+    BusyCalendar calendar;
+    std::string notice;
+    std::string suggestion;
     
     // Show initial help
     showHelp();
     
+    // Full-screen big-digit view, toggled with 'v'
+    BigTimerView bigTimer;
+    if (bigView) {
+        bigTimer.enter();
+    }
+    
     // Main loop
     while (true) {
-        // Update timer only if running and not paused
-        if (isTimerRunning && !isPaused) {
-            auto now = Clock::now();
-            elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
-            
-            // State machine
-            switch (currentState) {
-                case State::Focus: {
-                    int remaining = settings.getFocusDuration() * 60 - elapsedSeconds;
-                    if (remaining <= 0) {
-                        currentState = State::ExtendedFocus;
-                        totalFocusTime = settings.getFocusDuration() * 60;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                    }
-                    break;
-                }
-                case State::ExtendedFocus: {
-                    totalFocusTime = settings.getFocusDuration() * 60 + elapsedSeconds;
-                    break;
-                }
-                case State::Hyperfocus: {
-                    totalFocusTime = settings.getFocusDuration() * 60 + elapsedSeconds;
-                    break;
-                }
-                case State::Rest: {
-                    int remaining = settings.getRestDuration() * 60 - elapsedSeconds;
-                    if (remaining <= 0) {
-                        currentState = State::IdleAfterRest;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                    }
-                    break;
-                }
-                case State::IdleAfterRest:
-                    // Just count up
-                    break;
-            }
+        timer.update(Clock::now());
+        if (!timer.isRunning() || timer.getState() != State::Focus) {
+            notice.clear();
+        }
+        if (!timer.isRunning()) {
+            suggestion = suggestFocus(history.quality, logger.getTag(), settings);
+        }
+        if (httpPort >= 0) {
+            publishStatus(statusBoard, timer, history.tags.name(logger.getTag()));
         }
         
         // Display current status
-        displayTimer(currentState, elapsedSeconds, totalFocusTime, isTimerRunning, isPaused, settings);
+        if (bigTimer.isActive()) {
+            renderBigTimer(bigTimer, timer, history.tags.name(logger.getTag()), timer.isRunning() ? notice : suggestion);
+        } else {
+            displayTimer(timer.getState(), timer.getElapsedSeconds(), timer.getTotalFocusTime(),
+                         timer.isRunning(), timer.isPausedNow(), settings, history.tags.name(logger.getTag()),
+                         timer.getFocusDuration(), notice, suggestion);
+        }
         
         // Handle keyboard input (non-blocking)
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -322,111 +529,76 @@ int main() {
             
             switch (key) {
                 case 'q':
-                    logFile << getTimestamp() << " - Application quit\n";
-                    logFile.close();
+                    bigTimer.leave();
+                    logger.log(LogEvent::Quit);
+                    logger.close();
                     std::cout << "\nGoodbye!\n";
                     return 0;
                     
+                case 'v':
+                    if (bigTimer.isActive()) {
+                        bigTimer.leave();
+                    } else {
+                        bigTimer.enter();
+                    }
+                    break;
+                    
                 case 'h':
                     showHelp();
                     break;
                     
                 case 'c':
                     showSettings(settings);
+                    timer.setFocusDuration(settings.getFocusDuration());
+                    timer.setRestDuration(settings.getRestDuration());
                     break;
                     
                 case 's':
-                    if (!isTimerRunning) {
-                        isTimerRunning = true;
-                        isPaused = false;
-                        currentState = State::Focus;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                        totalFocusTime = 0;
-                        logFile << getTimestamp() << " - Session started\n";
+                    if (!timer.isRunning()) {
+                        logger.setTag(history.tags.intern(promptTag()));
+                        notice = focusNotice(calendar, timer, settings, history.quality, logger.getTag());
+                        timer.start(Clock::now());
                     }
                     break;
                     
                 case 'p':
-                    if (isTimerRunning) {
-                        if (isPaused) {
-                            isPaused = false;
-                            startTime += (Clock::now() - pauseTime);
-                            logFile << getTimestamp() << " - Session resumed\n";
-                        } else {
-                            isPaused = true;
-                            pauseTime = Clock::now();
-                            logFile << getTimestamp() << " - Session paused at " << formatTime(elapsedSeconds) << "\n";
-                        }
-                    }
+                    timer.togglePause(Clock::now());
                     break;
                     
                 case 'f':
-                    if (isTimerRunning) {
-                        if (currentState == State::Rest || currentState == State::IdleAfterRest) {
-                            // Start new focus session
-                            currentState = State::Focus;
-                            startTime = Clock::now();
-                            elapsedSeconds = 0;
-                            totalFocusTime = 0;
-                            isPaused = false;
-                            logFile << getTimestamp() << " - New focus session started\n";
-                        } else {
-                            // Finish current session
-                            isTimerRunning = false;
-                            isPaused = false;
-                            logFile << getTimestamp() << " - Session finished at " << formatTime(elapsedSeconds) << "\n";
-                        }
+                    if (timer.isRunning() && (timer.getState() == State::Rest ||
+                                              timer.getState() == State::IdleAfterRest)) {
+                        notice = focusNotice(calendar, timer, settings, history.quality, logger.getTag());
                     }
+                    timer.finish(Clock::now());
                     break;
                     
                 // Extended Focus feedback
                 case 'g':
-                    if (currentState == State::ExtendedFocus) {
-                        currentState = State::Rest;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                        logFile << getTimestamp() << " - Focus: " << totalFocusTime / 60 << " min (Good)\n";
-                    }
+                    timer.rate(Rating::Good, Clock::now());
                     break;
                     
                 case 'b':
-                    if (currentState == State::ExtendedFocus) {
-                        currentState = State::Rest;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                        logFile << getTimestamp() << " - Focus: " << totalFocusTime / 60 << " min (Bad)\n";
-                    }
+                    timer.rate(Rating::Bad, Clock::now());
                     break;
                     
                 case 'o':
-                    if (currentState == State::ExtendedFocus) {
-                        currentState = State::Rest;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                        logFile << getTimestamp() << " - Focus: " << totalFocusTime / 60 << " min (Okay)\n";
-                    }
+                    timer.rate(Rating::Okay, Clock::now());
                     break;
                     
                 // Hyperfocus
                 case 'r':
-                    if (currentState == State::Hyperfocus) {
-                        currentState = State::Rest;
-                        startTime = Clock::now();
-                        elapsedSeconds = 0;
-                        logFile << getTimestamp() << " - Hyperfocus: " << totalFocusTime / 60 << " min\n";
-                    }
+                    timer.rest(Clock::now());
                     break;
             }
             
             // Handle hyperfocus transition from extended focus
-            if (key == 'h' && currentState == State::ExtendedFocus) {
-                currentState = State::Hyperfocus;
-                logFile << getTimestamp() << " - Entered hyperfocus mode\n";
+            if (key == 'h') {
+                timer.enterHyperfocus();
             }
         }
     }
     
-    logFile.close();
+    logger.close();
     return 0;
 }
\ No newline at end of file
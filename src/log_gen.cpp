@@ -0,0 +1,391 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SessionLog.h"
+
+/**
+ * Synthetic session history for benchmarking everything that reads logs.
+ *
+ * Writes log.txt and tags.txt in the exact line formats of both timers:
+ * - CLI users log "Entered hyperfocus mode", "New focus session started"
+ *   between cycles, the elapsed time in "Session finished at", and end
+ *   some sessions with "Application quit";
+ * - GUI users log "Rest: N min" (the configured rest) or "Idle: N min"
+ *   when the next cycle starts and "Session finished at 00:00".
+ * Each user has their own focus/rest settings, day start, activity and
+ * format. Sessions have 1-6 cycles with occasional pauses, abandoned focus
+ * blocks, extended focus before the rating, hyperfocus and idle time after
+ * rest. Ratings lean towards Good in the morning and away from it at night.
+ *
+ *   pomodoro-gen [users=1] [years=1] [sessions=4] [start=2020-01-01] [good=0.5] [okay=0.3]
+ *                [hyperfocus=0.1] [format=mixed|cli|gui] [tags=8] [seed=1] [threads=N]
+ *                [dir=synthetic] [--force]
+ *
+ * One user goes to DIR/log.txt, several to DIR/user-NNN/log.txt. Every
+ * (user, month) chunk has its own random stream derived from the seed, so
+ * the output depends only on the parameters, not on the thread count.
+ * Chunks are generated in parallel and appended in order.
+ */
+
+namespace {
+
+struct Options {
+    int users = 1;
+    int years = 1;
+    double sessions = 4;        // mean per weekday
+    int64_t start = 0;
+    double good = 0.5;
+    double okay = 0.3;
+    double hyperfocus = 0.1;
+    std::string format = "mixed";
+    int tags = 8;
+    uint64_t seed = 1;
+    unsigned threads = 0;
+    std::string dir = "synthetic";
+    bool force = false;
+};
+
+// splitmix64: tiny, fast and identical on every platform (std distributions are not)
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+    bool chance(double p) { return uniform() < p; }
+    int between(int low, int high) { return low + static_cast<int>(next() % static_cast<uint64_t>(high - low + 1)); }
+    int64_t exponential(double mean) { return static_cast<int64_t>(-mean * std::log(1 - uniform())); }
+    int poisson(double mean) {
+        double limit = std::exp(-mean), product = uniform();
+        int count = 0;
+        while (product > limit) {
+            product *= uniform();
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    uint64_t state;
+};
+
+uint64_t streamSeed(uint64_t seed, uint64_t user, uint64_t chunk) {
+    Random random(seed * 0xD1B54A32D192ED03ull ^ (user << 32) ^ chunk);
+    return random.next();
+}
+
+struct User {
+    bool cli;
+    int focusMinutes;
+    int restMinutes;
+    int dayStartHour;
+    double activity;
+};
+
+User makeUser(const Options& options, int index) {
+    static const int focusChoices[] = { 10, 15, 20, 25, 25, 30, 45 };
+    static const int restChoices[] = { 3, 5, 5, 5, 10 };
+    Random random(streamSeed(options.seed, static_cast<uint64_t>(index), ~0ull));
+    User user;
+    user.cli = options.format == "cli" || (options.format == "mixed" && random.chance(0.5));
+    user.focusMinutes = focusChoices[random.next() % 7];
+    user.restMinutes = restChoices[random.next() % 5];
+    user.dayStartHour = random.between(6, 10);
+    user.activity = 0.5 + random.uniform();
+    return user;
+}
+
+// Appends log lines of one user
+class Writer {
+public:
+    explicit Writer(std::string& out) : out(out) {}
+
+    void emit(int64_t time, LogEvent event, uint32_t value = 0, Rating rating = Rating::None) {
+        record.timestamp = time;
+        record.event = event;
+        record.value = value;
+        record.rating = rating;
+        appendLogLine(record, out);
+        out.push_back('\n');
+    }
+    void setTag(uint32_t tagId) { record.tagId = tagId; }
+
+private:
+    std::string& out;
+    LogRecord record;
+};
+
+Rating drawRating(Random& random, const Options& options, int64_t time) {
+    int hour = static_cast<int>(((time % 86400) + 86400) % 86400 / 3600);
+    double factor = hour < 12 ? 1.2 : (hour >= 20 ? 0.7 : 1.0);
+    double good = std::min(0.95, options.good * factor);
+    double rest = 1 - options.good;
+    double okay = rest > 0 ? (1 - good) * options.okay / rest : 0;
+    double draw = random.uniform();
+    if (draw < good) return Rating::Good;
+    return draw < good + okay ? Rating::Okay : Rating::Bad;
+}
+
+// One session starting at t; returns its end
+int64_t generateSession(Writer& writer, Random& random, const User& user, const Options& options, int64_t t) {
+    writer.setTag(options.tags > 0 && random.chance(0.7) ? static_cast<uint32_t>(random.between(1, options.tags)) : 0);
+    writer.emit(t, LogEvent::SessionStarted);
+
+    const int focusSeconds = user.focusMinutes * 60;
+    const int restSeconds = user.restMinutes * 60;
+    for (int cycle = 0;; ++cycle) {
+        // Focus, maybe paused once
+        int pausedAt = 0;
+        if (random.chance(0.15)) {
+            pausedAt = random.between(30, focusSeconds - 30);
+            int64_t pause = 60 + random.exponential(240);
+            writer.emit(t + pausedAt, LogEvent::SessionPaused, static_cast<uint32_t>(pausedAt));
+            writer.emit(t + pausedAt + pause, LogEvent::SessionResumed);
+            t += pause;
+        }
+        if (random.chance(0.04)) {
+            int at = random.between(std::max(60, pausedAt + 1), focusSeconds - 1);
+            t += at;
+            writer.emit(t, LogEvent::SessionFinished, user.cli ? static_cast<uint32_t>(at) : 0);
+            break;
+        }
+
+        // Bell, extended focus, then rating or hyperfocus
+        int64_t extended = random.exponential(180);
+        t += focusSeconds + extended;
+        if (random.chance(options.hyperfocus)) {
+            if (user.cli) writer.emit(t, LogEvent::EnteredHyperfocus);
+            int64_t hyperfocus = 600 + random.exponential(1800);
+            t += hyperfocus;
+            writer.emit(t, LogEvent::Hyperfocus, static_cast<uint32_t>((focusSeconds + extended + hyperfocus) / 60));
+        } else {
+            writer.emit(t, LogEvent::Focus, static_cast<uint32_t>((focusSeconds + extended) / 60),
+                        drawRating(random, options, t));
+        }
+
+        // Rest, ended early or followed by idle time
+        bool early = random.chance(0.6);
+        int64_t taken = early ? random.between(restSeconds / 2, restSeconds) : restSeconds + random.exponential(240);
+        if (cycle == 5 || !random.chance(0.6)) {
+            t += random.between(10, static_cast<int>(taken));
+            if (!user.cli) {
+                writer.emit(t, LogEvent::SessionFinished, 0);
+            } else if (random.chance(0.3)) {
+                writer.emit(t, LogEvent::Quit);
+            } else {
+                // 'f' in Rest starts a new focus block, a second 'f' ends the session
+                int seconds = random.between(1, 5);
+                writer.emit(t, LogEvent::NewFocus);
+                t += seconds;
+                writer.emit(t, LogEvent::SessionFinished, static_cast<uint32_t>(seconds));
+            }
+            break;
+        }
+        t += taken;
+        if (user.cli) {
+            writer.emit(t, LogEvent::NewFocus);
+        } else if (taken <= restSeconds) {
+            writer.emit(t, LogEvent::Rest, static_cast<uint32_t>(user.restMinutes));
+        } else {
+            writer.emit(t, LogEvent::Idle, static_cast<uint32_t>((taken - restSeconds) / 60));
+        }
+    }
+    writer.setTag(0);
+    return t;
+}
+
+// Every day in [from, to) (both local midnights)
+void generateChunk(const User& user, const Options& options, int64_t from, int64_t to, Random& random,
+                   std::string& out) {
+    Writer writer(out);
+    int64_t end = from;
+    for (int64_t day = from; day < to; day += 86400) {
+        int weekday = static_cast<int>((epochDay(day) + 4) % 7);
+        bool weekend = weekday == 0 || weekday == 6;
+        int count = random.poisson(options.sessions * user.activity * (weekend ? 0.4 : 1.0));
+        int64_t t = std::max(end, day + user.dayStartHour * 3600 + random.exponential(1800));
+        for (int session = 0; session < count && t < day + 22 * 3600; ++session) {
+            end = generateSession(writer, random, user, options, t);
+            t = end + 300 + random.exponential(5400);
+        }
+    }
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    options.start = civilToEpoch(2020, 1, 1);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        std::string key = arg.substr(0, equals);
+        std::string value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+        if (arg == "--force") {
+            options.force = true;
+        } else if (key == "users" && parseOptionValue(value, options.users) && options.users >= 1) {
+        } else if (key == "years" && parseOptionValue(value, options.years) && options.years >= 1) {
+        } else if (key == "sessions" && parseOptionValue(value, options.sessions) && options.sessions >= 0) {
+        } else if (key == "start" && value.size() == 10 &&
+                   parseEpoch(value.data(), value.size(), options.start) &&
+                   formatEpoch(options.start).compare(0, 10, value) == 0) {
+            // The round trip rejects days past the end of the month, e.g. 2021-02-30
+        } else if (key == "good" && parseOptionValue(value, options.good)) {
+        } else if (key == "okay" && parseOptionValue(value, options.okay)) {
+        } else if (key == "hyperfocus" && parseOptionValue(value, options.hyperfocus)) {
+        } else if (key == "format" && (value == "mixed" || value == "cli" || value == "gui")) {
+            options.format = value;
+        } else if (key == "tags" && parseOptionValue(value, options.tags) && options.tags >= 0) {
+        } else if (key == "seed" && parseOptionValue(value, options.seed)) {
+        } else if (key == "threads" && parseOptionValue(value, options.threads) && options.threads >= 1) {
+        } else if (key == "dir" && !value.empty()) {
+            options.dir = value;
+        } else {
+            std::cerr << "Error: invalid option " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options.good < 0 || options.okay < 0 || options.good + options.okay > 1 ||
+        options.hyperfocus < 0 || options.hyperfocus > 1) {
+        std::cerr << "Error: good + okay and hyperfocus must lie in [0, 1]" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void writeTags(const std::string& path, int count) {
+    static const char* const names[] = { "writing", "email", "coding", "reading", "study", "planning",
+                                         "admin", "design", "review", "research" };
+    std::ofstream tagsFile(path);
+    for (int id = 1; id <= count; ++id) {
+        if (id <= 10) {
+            tagsFile << names[id - 1] << "\n";
+        } else {
+            tagsFile << "task-" << id << "\n";
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: pomodoro-gen [users=1] [years=1] [sessions=4] [start=YYYY-MM-DD] [good=0.5] [okay=0.3]\n"
+                     "                    [hyperfocus=0.1] [format=mixed|cli|gui] [tags=8] [seed=1] [threads=N]\n"
+                     "                    [dir=synthetic] [--force]" << std::endl;
+        return 1;
+    }
+
+    // Output files, never overwriting a log unless asked to
+    std::vector<std::string> logPaths;
+    std::error_code error;
+    for (int user = 0; user < options.users; ++user) {
+        std::filesystem::path dir(options.dir);
+        if (options.users > 1) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "user-%03d", user + 1);
+            dir /= name;
+        }
+        std::filesystem::create_directories(dir, error);
+        std::string logPath = (dir / "log.txt").string();
+        if (!options.force && std::filesystem::exists(logPath)) {
+            std::cerr << "Error: " << logPath << " exists (use --force to overwrite)" << std::endl;
+            return 1;
+        }
+        writeTags((dir / "tags.txt").string(), options.tags);
+        logPaths.push_back(logPath);
+    }
+
+    // Chunks: one calendar month of one user, in output order
+    struct Chunk {
+        int user;
+        int64_t from;
+        int64_t to;
+    };
+    std::vector<Chunk> chunks;
+    int year, month, day, hour, minute, second;
+    epochToCivil(options.start, year, month, day, hour, minute, second);
+    const int monthsPerUser = options.years * 12;
+    auto chunkStart = [&](int index) {
+        if (index == 0) return options.start;
+        if (index == monthsPerUser) return civilToEpoch(year + options.years, month, day);
+        return civilToEpoch(year + (month - 1 + index) / 12, (month - 1 + index) % 12 + 1, 1);
+    };
+    for (int user = 0; user < options.users; ++user) {
+        for (int index = 0; index < monthsPerUser; ++index) {
+            chunks.push_back({ user, chunkStart(index), chunkStart(index + 1) });
+        }
+    }
+    std::vector<User> users;
+    for (int user = 0; user < options.users; ++user) users.push_back(makeUser(options, user));
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(chunks.size()));
+    std::atomic<size_t> nextChunk(0);
+    std::mutex mutex;
+    std::condition_variable written;
+    size_t nextToWrite = 0;
+    std::FILE* file = nullptr;
+    uint64_t bytes = 0, lines = 0;
+    bool failed = false;
+
+    auto start = std::chrono::steady_clock::now();
+    auto work = [&]() {
+        std::string buffer;
+        for (size_t index; (index = nextChunk.fetch_add(1)) < chunks.size();) {
+            const Chunk& chunk = chunks[index];
+            Random random(streamSeed(options.seed, static_cast<uint64_t>(chunk.user),
+                                     static_cast<uint64_t>(index % monthsPerUser)));
+            buffer.clear();
+            generateChunk(users[chunk.user], options, chunk.from, chunk.to, random, buffer);
+            uint64_t chunkLines = static_cast<uint64_t>(std::count(buffer.begin(), buffer.end(), '\n'));
+
+            // Append in chunk order; the next chunk's owner is at most threads - 1 chunks ahead
+            std::unique_lock<std::mutex> lock(mutex);
+            written.wait(lock, [&]() { return nextToWrite == index; });
+            bool firstOfUser = index % monthsPerUser == 0;
+            if (firstOfUser) {
+                if (file) std::fclose(file);
+                file = std::fopen(logPaths[chunk.user].c_str(), "wb");
+                if (!file) {
+                    std::cerr << "Error: Could not write " << logPaths[chunk.user] << std::endl;
+                    failed = true;
+                }
+            }
+            if (file && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+                std::cerr << "Error: Could not write " << logPaths[chunk.user] << std::endl;
+                failed = true;
+            }
+            bytes += buffer.size();
+            lines += chunkLines;
+            ++nextToWrite;
+            written.notify_all();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) pool.emplace_back(work);
+    work();
+    for (std::thread& thread : pool) thread.join();
+    if (file && std::fclose(file) != 0) failed = true;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << options.users << " user(s), " << options.years << " year(s): " << lines << " lines, "
+              << std::fixed << std::setprecision(1) << bytes / 1e6 << " MB in " << std::setprecision(2)
+              << seconds << " s (" << std::setprecision(0) << bytes / 1e6 / seconds << " MB/s, "
+              << threads << " thread(s)) -> " << options.dir << std::endl;
+    return failed ? 1 : 0;
+}
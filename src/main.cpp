@@ -1,12 +1,22 @@
 #include <SFML/Graphics.hpp>
-#include <windows.h>
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <string>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
+#include <vector>
 #include "Settings.h"
+#include "SessionLog.h"
+#include "SessionHistory.h"
+#include "LogArchive.h"
+#include "HeatmapPanel.h"
+#include "TimelineWindow.h"
+#include "WindowPlatform.h"
 
 // Timer states
 enum class State {
@@ -20,7 +30,6 @@ enum class State {
 // Helper function declarations
 bool isPointInRect(const sf::Vector2i& point, const sf::FloatRect& rect);
 std::string formatTime(int seconds);
-std::string getTimestamp();
 
 // Convert seconds to MM:SS format
 std::string formatTime(int seconds) {
@@ -32,65 +41,283 @@ std::string formatTime(int seconds) {
     return oss.str();
 }
 
-// Get current timestamp for logging
-std::string getTimestamp() {
-    auto now = std::time(nullptr);
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S");
-    return oss.str();
-}
-
 // Check if a point is inside a rectangle
 bool isPointInRect(const sf::Vector2i& point, const sf::FloatRect& rect) {
     return point.x >= rect.left && point.x <= rect.left + rect.width &&
            point.y >= rect.top && point.y <= rect.top + rect.height;
 }
 
-int main() {
-    // Initialize window with fixed size and no resize
-    sf::RenderWindow window(sf::VideoMode(300, 130), "ADHD Pomodoro Timer", sf::Style::Titlebar | sf::Style::Close);
-    HWND hwnd = window.getSystemHandle();
-    SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE); // Always on top
-
-    // Load font
-    sf::Font font;
-    if (!font.loadFromFile("D:/CodeSSD/CLion/ADHDPomodoro/dll/arial.ttf")) {
-        std::cerr << "Error: Failed to load font" << std::endl;
-        return 1; // Exit if font fails to load
-    } else {
-        std::cout << "Font loaded successfully" << std::endl;
+// The bundled font path of the Windows build, then common Linux fonts
+bool loadFont(sf::Font& font) {
+    static const char* const candidates[] = {
+        "D:/CodeSSD/CLion/ADHDPomodoro/dll/arial.ttf",
+        "dll/arial.ttf",
+        "arial.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+        "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
+    };
+    for (const char* path : candidates) {
+        if (std::ifstream(path).good() && font.loadFromFile(path)) {
+            return true;
+        }
     }
+    return false;
+}
+
+const unsigned timerHeight = 130;
+
+// Widgets of the main window
+struct MainView {
+    explicit MainView(const sf::Font& font);
+
+    sf::Text timerText;
+    sf::RectangleShape startButton;
+    sf::RectangleShape pauseButton;
+    sf::RectangleShape finishButton;
+    sf::Text startButtonText;
+    sf::Text pauseButtonText;
+    sf::Text finishButtonText;
+    sf::RectangleShape tagField;
+    sf::Text tagText;
+    sf::Text suggestionText;
+    sf::Text historyText;
+    sf::Text timelineText;
+};
 
+MainView::MainView(const sf::Font& font)
+    : timerText("", font, 20),
+      startButton(sf::Vector2f(100, 30)),
+      pauseButton(sf::Vector2f(100, 30)),
+      finishButton(sf::Vector2f(100, 30)),
+      startButtonText("Start", font, 16),
+      pauseButtonText("Pause", font, 16),
+      finishButtonText("Finish", font, 16),
+      tagField(sf::Vector2f(280, 22)),
+      tagText("", font, 14),
+      suggestionText("", font, 12),
+      historyText("History", font, 16),
+      timelineText("Timeline", font, 16) {
     // Set up text display
-    sf::Text timerText("", font, 20);
     timerText.setPosition(10, 40);
     timerText.setFillColor(sf::Color::Black);
 
     // Set up buttons
-    sf::RectangleShape startButton(sf::Vector2f(100, 30));
     startButton.setPosition(100, 70);
     startButton.setFillColor(sf::Color(200, 200, 200));
-
-    sf::RectangleShape pauseButton(sf::Vector2f(100, 30));
     pauseButton.setPosition(100, 70);
     pauseButton.setFillColor(sf::Color(200, 200, 200));
-
-    sf::RectangleShape finishButton(sf::Vector2f(100, 30));
     finishButton.setPosition(210, 70);
     finishButton.setFillColor(sf::Color(200, 200, 200));
 
-    sf::Text startButtonText("Start", font, 16);
     startButtonText.setPosition(125, 75);
     startButtonText.setFillColor(sf::Color::Black);
-
-    sf::Text pauseButtonText("Pause", font, 16);
     pauseButtonText.setPosition(125, 75);
     pauseButtonText.setFillColor(sf::Color::Black);
-
-    sf::Text finishButtonText("Finish", font, 16);
     finishButtonText.setPosition(225, 75);
     finishButtonText.setFillColor(sf::Color::Black);
 
+    // Tag field, edited while the timer is stopped
+    tagField.setPosition(10, 104);
+    tagField.setFillColor(sf::Color(245, 245, 245));
+    tagField.setOutlineColor(sf::Color(200, 200, 200));
+    tagField.setOutlineThickness(1);
+    tagText.setPosition(14, 106);
+    tagText.setFillColor(sf::Color(50, 50, 50));
+
+    // Quality model suggestion, left of the Start button
+    suggestionText.setPosition(10, 70);
+    suggestionText.setFillColor(sf::Color(90, 90, 90));
+
+    // History menu item toggling the heatmap panel below the timer
+    historyText.setPosition(90, 5);
+    historyText.setFillColor(sf::Color(50, 50, 50));
+
+    // Timeline menu item opening the session list window
+    timelineText.setPosition(170, 5);
+    timelineText.setFillColor(sf::Color(50, 50, 50));
+}
+
+// Text of the timer display
+std::string timerLabel(State state, bool isTimerRunning, bool isPaused, int elapsedSeconds, int totalFocusTime,
+                       const Settings& settings) {
+    if (isPaused) {
+        return "Paused: " + formatTime(elapsedSeconds) + "\nClick Pause to resume";
+    }
+    if (!isTimerRunning) {
+        return "Click Start to begin";
+    }
+    switch (state) {
+        case State::Focus:
+            return "Focus: " + formatTime(settings.getFocusDuration() * 60 - elapsedSeconds);
+        case State::ExtendedFocus:
+            return "Extended Focus: " + formatTime(totalFocusTime) + "\nG/B/O/H";
+        case State::Hyperfocus:
+            return "Hyperfocus: " + formatTime(totalFocusTime) + "\nPress R for Rest";
+        case State::Rest:
+            return "Rest: " + formatTime(settings.getRestDuration() * 60 - elapsedSeconds) + "\nPress F to Focus";
+        case State::IdleAfterRest:
+            return "Idle: " + formatTime(elapsedSeconds) + "\nPress F to Focus";
+    }
+    return "";
+}
+
+// Two short lines for the Ready screen from the quality model
+std::string suggestionLabel(const QualityModel& model, uint32_t tagId, const Settings& settings) {
+    QualityModel::Suggestion suggestion =
+        model.suggest(localNow(), tagId, settings.getFocusDuration(), settings.getRestDuration());
+    if (!suggestion.ready) {
+        return "Rated: " + std::to_string(model.getSamples()) + "/" + std::to_string(QualityModel::minimumSamples);
+    }
+    return "Try " + std::to_string(suggestion.focusMinutes) + "/" + std::to_string(suggestion.restMinutes) +
+           " min\nGood: " + std::to_string(static_cast<int>(suggestion.probability * 100 + 0.5)) + "%";
+}
+
+// One frame of the main window, without display()
+void drawMainView(sf::RenderTarget& target, MainView& view, Settings& settings, HeatmapPanel& heatmap,
+                  sf::Font& font, const sf::Vector2i& mousePos, bool isTimerRunning, const std::string& tagInput) {
+    target.clear(sf::Color::White);
+    settings.drawMenuBar(target, font, mousePos);
+    target.draw(view.historyText);
+    target.draw(view.timelineText);
+    target.draw(view.timerText);
+    heatmap.draw(target, font, static_cast<float>(timerHeight));
+
+    if (!isTimerRunning) {
+        target.draw(view.startButton);
+        target.draw(view.startButtonText);
+        target.draw(view.suggestionText);
+        view.tagText.setString(tagInput.empty() ? "Tag (type to set)" : "Tag: " + tagInput);
+        target.draw(view.tagField);
+        target.draw(view.tagText);
+    } else {
+        target.draw(view.pauseButton);
+        target.draw(view.pauseButtonText);
+        target.draw(view.finishButton);
+        target.draw(view.finishButtonText);
+    }
+}
+
+/**
+ * --bench-render N: draw N frames of every UI state into an offscreen
+ * texture and report the CPU time per frame. The timer text changes every
+ * frame like a running timer. Each state ends by reading the texture back,
+ * so deferred GL work (e.g. llvmpipe under Xvfb) is included in its wall time.
+ */
+int runRenderBench(int frames, sf::Font& font) {
+    struct BenchState {
+        const char* name;
+        State state;
+        bool running;
+        bool paused;
+        bool heatmap;
+    };
+    const BenchState states[] = {
+        {"ready", State::Focus, false, false, false},
+        {"focus", State::Focus, true, false, false},
+        {"extended", State::ExtendedFocus, true, false, false},
+        {"hyperfocus", State::Hyperfocus, true, false, false},
+        {"rest", State::Rest, true, false, false},
+        {"idle", State::IdleAfterRest, true, false, false},
+        {"paused", State::Focus, true, true, false},
+        {"ready+history", State::Focus, false, false, true},
+        {"focus+history", State::Focus, true, false, true},
+    };
+
+    Settings settings;
+    SessionHistory history;
+    HeatmapPanel heatmap(history.rollups);
+    MainView view(font);
+    const sf::Vector2i mousePos(-1, -1);
+    const std::string tagInput = "bench";
+    view.suggestionText.setString(suggestionLabel(history.quality, 0, settings));
+
+    std::cout << "Rendering " << frames << " frame(s) per state offscreen\n";
+    std::cout << std::left << std::setw(16) << "state" << std::right
+              << std::setw(12) << "cpu ms/f" << std::setw(12) << "p99 cpu ms"
+              << std::setw(12) << "wall ms/f" << "\n";
+
+    double totalCpu = 0;
+    int totalFrames = 0;
+    for (const BenchState& bench : states) {
+        if (heatmap.isVisible() != bench.heatmap) {
+            heatmap.toggle();
+        }
+        unsigned height = timerHeight + (bench.heatmap ? static_cast<unsigned>(heatmap.getHeight()) : 0);
+        sf::RenderTexture target;
+        if (!target.create(300, height)) {
+            std::cerr << "Error: Failed to create a " << 300 << "x" << height << " render texture" << std::endl;
+            return 1;
+        }
+
+        std::vector<double> cpuTimes;
+        cpuTimes.reserve(frames);
+        auto wallStart = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            std::clock_t cpuStart = std::clock();
+            int elapsedSeconds = frame % 3600;
+            int totalFocusTime = settings.getFocusDuration() * 60 + elapsedSeconds;
+            view.timerText.setString(timerLabel(bench.state, bench.running, bench.paused, elapsedSeconds,
+                                                totalFocusTime, settings));
+            drawMainView(target, view, settings, heatmap, font, mousePos, bench.running, tagInput);
+            target.display();
+            cpuTimes.push_back(1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC);
+        }
+        target.getTexture().copyToImage();
+        double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+
+        double cpu = 0;
+        for (double t : cpuTimes) cpu += t;
+        std::sort(cpuTimes.begin(), cpuTimes.end());
+        double p99 = cpuTimes.empty() ? 0 : cpuTimes[std::min(cpuTimes.size() - 1, cpuTimes.size() * 99 / 100)];
+        totalCpu += cpu;
+        totalFrames += frames;
+
+        std::cout << std::left << std::setw(16) << bench.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << (frames ? cpu / frames : 0) << std::setw(12) << p99
+                  << std::setw(12) << (frames ? wall / frames : 0) << "\n";
+    }
+    std::cout << "All states: " << std::fixed << std::setprecision(3)
+              << (totalFrames ? totalCpu / totalFrames : 0) << " ms CPU per frame" << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    int benchFrames = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-render") == 0) {
+            benchFrames = i + 1 < argc ? std::atoi(argv[++i]) : 0;
+            if (benchFrames <= 0) {
+                std::cerr << "Usage: ADHDPomodoro [--bench-render N]" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // Load font
+    sf::Font font;
+    if (!loadFont(font)) {
+        std::cerr << "Error: Failed to load font" << std::endl;
+        return 1; // Exit if font fails to load
+    } else {
+        std::cout << "Font loaded successfully" << std::endl;
+    }
+
+    if (benchFrames > 0) {
+        return runRenderBench(benchFrames, font);
+    }
+
+    // Initialize window with fixed size and no resize
+    sf::RenderWindow window(sf::VideoMode(300, 130), "ADHD Pomodoro Timer", sf::Style::Titlebar | sf::Style::Close);
+    setAlwaysOnTop(window.getSystemHandle());
+
+    MainView view(font);
+    sf::Text& timerText = view.timerText;
+    sf::Text& historyText = view.historyText;
+    sf::Text& timelineText = view.timelineText;
+    std::string tagInput;
+
     // Initialize settings
     Settings settings;
 
@@ -104,15 +331,45 @@ int main() {
     int totalFocusTime = 0;      // For ExtendedFocus and Hyperfocus
     bool isTimerRunning = false;
     bool isPaused = false;
-    std::ofstream logFile("log.txt", std::ios::app);
 
+    // Session log with per-tag aggregates, the search index and time-series rollups
+    SessionLogger logger;
+    SessionHistory history;
+    history.updateIndexOnLog = false;      // the timeline window updates it on its worker thread
+    history.attach(logger);
+    // Log rotation (rotation.txt) and background compaction of sealed segments
+    LogArchiver archiver;
+    archiver.attach(logger);
+    HeatmapPanel heatmap(history.rollups);
+    TimelineWindow timeline(history.index, history.tags);
+    logger.addListener([&heatmap, &timeline](const LogRecord& record) {
+        if (record.event == LogEvent::Focus || record.event == LogEvent::Hyperfocus) {
+            heatmap.markDirty();
+            timeline.refresh();
+        }
+    });
+
+    bool placedOnTop = false;
     while (window.isOpen()) {
         // Handle events
         sf::Event event;
         while (window.pollEvent(event)) {
+            if (!placedOnTop) {
+                // The window manager has taken the window over by now; ask again in case it missed the first hint
+                setAlwaysOnTop(window.getSystemHandle());
+                placedOnTop = true;
+            }
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            else if (event.type == sf::Event::TextEntered && !isTimerRunning) {
+                sf::Uint32 c = event.text.unicode;
+                if (c == 8) { // Backspace
+                    if (!tagInput.empty()) tagInput.pop_back();
+                } else if (c >= 32 && c < 127 && tagInput.size() < 32) {
+                    tagInput.push_back(static_cast<char>(c));
+                }
+            }
             else if (event.type == sf::Event::MouseButtonPressed) {
                 if (event.mouseButton.button == sf::Mouse::Left) {
                     sf::Vector2i mousePos(event.mouseButton.x, event.mouseButton.y);
@@ -122,48 +379,65 @@ int main() {
                         continue;
                     }
 
+                    // Handle history menu click
+                    if (mousePos.y < 30 && isPointInRect(mousePos, historyText.getGlobalBounds())) {
+                        heatmap.toggle();
+                        unsigned height = timerHeight + (heatmap.isVisible() ? static_cast<unsigned>(heatmap.getHeight()) : 0);
+                        window.setSize(sf::Vector2u(300, height));
+                        window.setView(sf::View(sf::FloatRect(0, 0, 300, static_cast<float>(height))));
+                        continue;
+                    }
+
+                    // Handle timeline menu click
+                    if (mousePos.y < 30 && isPointInRect(mousePos, timelineText.getGlobalBounds())) {
+                        timeline.toggle();
+                        continue;
+                    }
+
                     // Handle start button click
-                    if (!isTimerRunning && isPointInRect(mousePos, startButton.getGlobalBounds())) {
+                    if (!isTimerRunning && isPointInRect(mousePos, view.startButton.getGlobalBounds())) {
                         isTimerRunning = true;
                         isPaused = false;
                         startTime = Clock::now();
-                        logFile << getTimestamp() << " - Session started\n";
+                        logger.setTag(history.tags.intern(tagInput));
+                        logger.log(LogEvent::SessionStarted);
                     }
                     // Handle pause button click
-                    else if (isTimerRunning && !isPaused && isPointInRect(mousePos, pauseButton.getGlobalBounds())) {
+                    else if (isTimerRunning && !isPaused && isPointInRect(mousePos, view.pauseButton.getGlobalBounds())) {
                         isPaused = true;
                         pauseTime = Clock::now();
-                        logFile << getTimestamp() << " - Session paused at " << formatTime(elapsedSeconds) << "\n";
+                        logger.log(LogEvent::SessionPaused, elapsedSeconds);
                     }
                     // Handle resume button click
-                    else if (isTimerRunning && isPaused && isPointInRect(mousePos, pauseButton.getGlobalBounds())) {
+                    else if (isTimerRunning && isPaused && isPointInRect(mousePos, view.pauseButton.getGlobalBounds())) {
                         isPaused = false;
                         startTime += (Clock::now() - pauseTime);
-                        logFile << getTimestamp() << " - Session resumed\n";
+                        logger.log(LogEvent::SessionResumed);
                     }
                     // Handle finish button click
-                    else if (isTimerRunning && isPointInRect(mousePos, finishButton.getGlobalBounds())) {
+                    else if (isTimerRunning && isPointInRect(mousePos, view.finishButton.getGlobalBounds())) {
                         isTimerRunning = false;
                         isPaused = false;
                         elapsedSeconds = 0;
-                        logFile << getTimestamp() << " - Session finished at " << formatTime(elapsedSeconds) << "\n";
+                        logger.log(LogEvent::SessionFinished, elapsedSeconds);
+                        logger.setTag(0);
                     }
                 }
             }
-            if (event.type == sf::Event::KeyPressed) {
+            if (event.type == sf::Event::KeyPressed && isTimerRunning) {
                 if (currentState == State::ExtendedFocus) {
                     if (event.key.code == sf::Keyboard::G) { // Good
                         currentState = State::Rest;
                         startTime = Clock::now();
-                        logFile << getTimestamp() << " - Focus: " << totalFocusTime / 60 << " min (Good)\n";
+                        logger.log(LogEvent::Focus, totalFocusTime / 60, Rating::Good);
                     } else if (event.key.code == sf::Keyboard::B) { // Bad
                         currentState = State::Rest;
                         startTime = Clock::now();
-                        logFile << getTimestamp() << " - Focus: " << totalFocusTime / 60 << " min (Bad)\n";
+                        logger.log(LogEvent::Focus, totalFocusTime / 60, Rating::Bad);
                     } else if (event.key.code == sf::Keyboard::O) { // Okay
                         currentState = State::Rest;
                         startTime = Clock::now();
-                        logFile << getTimestamp() << " - Focus: " << totalFocusTime / 60 << " min (Okay)\n";
+                        logger.log(LogEvent::Focus, totalFocusTime / 60, Rating::Okay);
                     } else if (event.key.code == sf::Keyboard::H) { // Hyperfocus
                         currentState = State::Hyperfocus;
                     }
@@ -171,15 +445,15 @@ int main() {
                     currentState = State::Rest;
                     int restDuration = totalFocusTime / 2; // Rest is half of hyperfocus duration
                     startTime = Clock::now();
-                    logFile << getTimestamp() << " - Hyperfocus: " << totalFocusTime / 60 << " min\n";
+                    logger.log(LogEvent::Hyperfocus, totalFocusTime / 60);
                 } else if (currentState == State::Rest && event.key.code == sf::Keyboard::F) {
                     currentState = State::Focus;
                     startTime = Clock::now();
-                    logFile << getTimestamp() << " - Rest: " << settings.getRestDuration() << " min\n";
+                    logger.log(LogEvent::Rest, settings.getRestDuration());
                 } else if (currentState == State::IdleAfterRest && event.key.code == sf::Keyboard::F) {
                     currentState = State::Focus;
                     startTime = Clock::now();
-                    logFile << getTimestamp() << " - Idle: " << elapsedSeconds / 60 << " min\n";
+                    logger.log(LogEvent::Idle, elapsedSeconds / 60);
                 }
             }
         }
@@ -199,6 +473,9 @@ int main() {
             }
         }
 
+        // Handle timeline window events
+        timeline.handleEvents();
+
         // Update timer only if running and not paused
         if (isTimerRunning && !isPaused) {
             auto now = Clock::now();
@@ -206,62 +483,39 @@ int main() {
 
             // State machine
             switch (currentState) {
-                case State::Focus: {
-                    int remaining = settings.getFocusDuration() * 60 - elapsedSeconds;
-                    if (remaining <= 0) {
+                case State::Focus:
+                    if (settings.getFocusDuration() * 60 - elapsedSeconds <= 0) {
                         currentState = State::ExtendedFocus;
                         totalFocusTime = settings.getFocusDuration() * 60;
                     }
-                    timerText.setString("Focus: " + formatTime(remaining));
                     break;
-                }
-                case State::ExtendedFocus: {
-                    totalFocusTime = settings.getFocusDuration() * 60 + elapsedSeconds;
-                    timerText.setString("Extended Focus: " + formatTime(totalFocusTime) + "\nG/B/O/H");
-                    break;
-                }
-                case State::Hyperfocus: {
+                case State::ExtendedFocus:
+                case State::Hyperfocus:
                     totalFocusTime = settings.getFocusDuration() * 60 + elapsedSeconds;
-                    timerText.setString("Hyperfocus: " + formatTime(totalFocusTime) + "\nPress R for Rest");
                     break;
-                }
-                case State::Rest: {
-                    int remaining = settings.getRestDuration() * 60 - elapsedSeconds;
-                    if (remaining <= 0) {
+                case State::Rest:
+                    if (settings.getRestDuration() * 60 - elapsedSeconds <= 0) {
                         currentState = State::IdleAfterRest;
                         startTime = Clock::now();
+                        elapsedSeconds = 0;
                     }
-                    timerText.setString("Rest: " + formatTime(remaining) + "\nPress F to Focus");
                     break;
-                }
-                case State::IdleAfterRest: {
-                    timerText.setString("Idle: " + formatTime(elapsedSeconds) + "\nPress F to Focus");
+                case State::IdleAfterRest:
                     break;
-                }
             }
-        } else if (isPaused) {
-            timerText.setString("Paused: " + formatTime(elapsedSeconds) + "\nClick Pause to resume");
-        } else {
-            timerText.setString("Click Start to begin");
         }
-
-        // Render
-        window.clear(sf::Color::White);
-        settings.drawMenuBar(window, font);
-        window.draw(timerText);
-        
+        timerText.setString(timerLabel(currentState, isTimerRunning, isPaused, elapsedSeconds, totalFocusTime, settings));
         if (!isTimerRunning) {
-            window.draw(startButton);
-            window.draw(startButtonText);
-        } else {
-            window.draw(pauseButton);
-            window.draw(isPaused ? pauseButtonText : pauseButtonText);
-            window.draw(finishButton);
-            window.draw(finishButtonText);
+            view.suggestionText.setString(suggestionLabel(history.quality, history.tags.find(tagInput), settings));
         }
+
+        // Render
+        drawMainView(window, view, settings, heatmap, font, sf::Mouse::getPosition(window),
+                     isTimerRunning, tagInput);
         window.display();
+        timeline.draw(font);
     }
 
-    logFile.close();
+    logger.close();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+/**
+ * End-to-end terminal benchmark for ADHDPomodoro-CLI.
+ *
+ * Runs the real CLI binary under a pseudo-terminal in a scratch directory,
+ * types a fixed script of keys and waits for the screen text each key should
+ * produce. Reports output bytes/sec, frames/sec (one frame = one
+ * displayTimer() screen) and key-to-screen latency as a single JSON object.
+ *
+ *   pomodoro-pty-bench [--cli PATH] [--seconds N] [--dir DIR] [--with-rating]
+ *
+ * --with-rating sets Focus to 1 minute and adds one full Focus -> Extended
+ * Focus -> 'g' -> Rest cycle at the start, so the run takes at least 70 s.
+ */
+
+#ifndef POMODORO_CLI_PATH
+#define POMODORO_CLI_PATH "./ADHDPomodoro-CLI"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Screen text that ends every displayTimer() frame
+const char* const frameMarker = "Press 'h' for help, 'c' for settings, 'q' to quit";
+
+struct Step {
+    const char* keys;
+    const char* expect;     // text that shows the key was handled
+    int timeoutMs;
+};
+
+// One loop of the script, starting and ending at "Ready to start"
+const Step mainScript[] = {
+    { "s", "Tag for this session", 2000 },
+    { "\n", "Status: FOCUS", 2000 },
+    { "p", "Status: PAUSED", 2000 },
+    { "p", "Status: FOCUS", 2000 },
+    { "c", "=== Settings ===", 2000 },
+    { "q", frameMarker, 2000 },
+    { "f", "Status: Ready to start", 2000 },
+    { "h", "Press any key to continue", 2000 },
+    { " ", frameMarker, 2000 },
+};
+
+// Reached only with a 1-minute Focus duration
+const Step ratingScript[] = {
+    { "s", "Tag for this session", 2000 },
+    { "\n", "Status: FOCUS", 2000 },
+    { "", "Status: EXTENDED FOCUS", 70000 },
+    { "g", "Status: REST", 2000 },
+    { "f", "Status: FOCUS", 2000 },
+    { "f", "Status: Ready to start", 2000 },
+};
+
+// Counts occurrences of a marker in a byte stream split into arbitrary chunks
+class MarkerCounter {
+public:
+    explicit MarkerCounter(const std::string& marker) : marker(marker), count(0) {}
+
+    void feed(const char* data, size_t length) {
+        tail.append(data, length);
+        size_t pos = 0;
+        while ((pos = tail.find(marker, pos)) != std::string::npos) {
+            count++;
+            pos += marker.size();
+        }
+        if (tail.size() >= marker.size()) tail.erase(0, tail.size() - (marker.size() - 1));
+    }
+
+    uint64_t getCount() const { return count; }
+
+private:
+    std::string marker;
+    std::string tail;
+    uint64_t count;
+};
+
+class PtyProcess {
+public:
+    PtyProcess() : master(-1), pid(-1), bytesRead(0), frames(frameMarker), clears("\x1b[2J") {}
+    ~PtyProcess() { stop(); }
+
+    bool spawn(const std::string& cliPath, const std::string& dir) {
+        struct winsize size;
+        std::memset(&size, 0, sizeof(size));
+        size.ws_row = 24;
+        size.ws_col = 80;
+        pid = forkpty(&master, nullptr, nullptr, &size);
+        if (pid < 0) {
+            std::cerr << "Error: forkpty failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        if (pid == 0) {
+            if (chdir(dir.c_str()) != 0) _exit(127);
+            setenv("TERM", "xterm", 0);
+            execl(cliPath.c_str(), cliPath.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+        return true;
+    }
+
+    void send(const char* keys) {
+        size_t length = std::strlen(keys);
+        if (length > 0 && write(master, keys, length) < 0) {
+            std::cerr << "Error: write to pty failed" << std::endl;
+        }
+    }
+
+    // Read until the text appears after the current position or the deadline passes
+    bool waitFor(const std::string& text, Clock::time_point deadline) {
+        size_t searchFrom = 0;
+        screen.clear();
+        while (true) {
+            if (screen.find(text, searchFrom) != std::string::npos) return true;
+            searchFrom = screen.size() >= text.size() ? screen.size() - text.size() + 1 : 0;
+            int waitMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count());
+            if (waitMs <= 0 || readSome(waitMs) < 0) return false;
+        }
+    }
+
+    // Drain output for a while without looking for anything
+    void pump(Clock::time_point until) {
+        while (true) {
+            int waitMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(until - Clock::now()).count());
+            if (waitMs <= 0 || readSome(waitMs) < 0) return;
+        }
+    }
+
+    // Consume whatever is already buffered so old screens cannot match
+    void drain() {
+        while (readSome(0) > 0) {}
+    }
+
+    void stop() {
+        if (pid > 0) {
+            send("q");
+            Clock::time_point deadline = Clock::now() + std::chrono::seconds(2);
+            int status;
+            while (waitpid(pid, &status, WNOHANG) == 0) {
+                if (Clock::now() > deadline) {
+                    kill(pid, SIGKILL);
+                    waitpid(pid, &status, 0);
+                    break;
+                }
+                readSome(50);
+            }
+            pid = -1;
+        }
+        if (master >= 0) {
+            close(master);
+            master = -1;
+        }
+    }
+
+    uint64_t getBytes() const { return bytesRead; }
+    uint64_t getFrames() const { return frames.getCount(); }
+    uint64_t getClears() const { return clears.getCount(); }
+
+private:
+    int master;
+    pid_t pid;
+    uint64_t bytesRead;
+    MarkerCounter frames;
+    MarkerCounter clears;
+    std::string screen;     // output since the last waitFor() began
+    char buffer[65536];
+
+    // Bytes read, 0 on timeout, -1 once the child has exited (EIO)
+    ssize_t readSome(int timeoutMs) {
+        struct pollfd fd;
+        fd.fd = master;
+        fd.events = POLLIN;
+        fd.revents = 0;
+        if (poll(&fd, 1, timeoutMs) <= 0) return 0;
+        ssize_t n = read(master, buffer, sizeof(buffer));
+        if (n <= 0) return (n < 0 && errno == EAGAIN) ? 0 : -1;
+        bytesRead += static_cast<uint64_t>(n);
+        frames.feed(buffer, static_cast<size_t>(n));
+        clears.feed(buffer, static_cast<size_t>(n));
+        screen.append(buffer, static_cast<size_t>(n));
+        return n;
+    }
+};
+
+// A scratch directory this tool created, removed with everything the CLI wrote into it
+class ScratchDirectory {
+public:
+    ~ScratchDirectory() {
+        if (path.empty()) return;
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+
+    std::string path;
+};
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+    return values[std::min(rank, values.size() - 1)];
+}
+
+std::string keyName(const char* keys) {
+    if (std::strcmp(keys, "\n") == 0) return "enter";
+    if (std::strcmp(keys, " ") == 0) return "space";
+    return keys;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string cliPath = POMODORO_CLI_PATH;
+    std::string dir;
+    double seconds = 10;
+    bool withRating = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--cli" && i + 1 < argc) {
+            cliPath = argv[++i];
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else if (arg == "--dir" && i + 1 < argc) {
+            dir = argv[++i];
+        } else if (arg == "--with-rating") {
+            withRating = true;
+        } else {
+            std::cerr << "Usage: pomodoro-pty-bench [--cli PATH] [--seconds N] [--dir DIR] [--with-rating]" << std::endl;
+            return 1;
+        }
+    }
+    if (access(cliPath.c_str(), X_OK) != 0) {
+        std::cerr << "Error: Cannot run " << cliPath << " (use --cli PATH)" << std::endl;
+        return 1;
+    }
+
+    // Scratch directory so the run never touches the user's log and settings. Declared before
+    // the CLI process, so it is removed only after the child has been reaped on every return.
+    ScratchDirectory scratch;
+    if (dir.empty()) {
+        char name[] = "/tmp/pomodoro-pty-bench-XXXXXX";
+        if (!mkdtemp(name)) {
+            std::cerr << "Error: Could not create a scratch directory" << std::endl;
+            return 1;
+        }
+        dir = name;
+        scratch.path = dir;
+    }
+    {
+        std::ofstream settingsFile(dir + "/settings.txt");
+        settingsFile << (withRating ? 1 : 25) << " " << 5;
+    }
+
+    PtyProcess cli;
+    if (!cli.spawn(cliPath, dir)) return 1;
+
+    Clock::time_point start = Clock::now();
+    // Initial help screen waits for a key
+    if (!cli.waitFor("Press any key to continue", start + std::chrono::seconds(5))) {
+        std::cerr << "Error: CLI did not show its help screen" << std::endl;
+        return 1;
+    }
+    cli.send(" ");
+    cli.waitFor(frameMarker, Clock::now() + std::chrono::seconds(2));
+
+    std::vector<double> latencies;
+    std::map<std::string, std::vector<double>> latenciesByKey;
+    uint64_t timeouts = 0;
+
+    auto runStep = [&](const Step& step) {
+        cli.drain();
+        Clock::time_point sent = Clock::now();
+        cli.send(step.keys);
+        bool seen = cli.waitFor(step.expect, sent + std::chrono::milliseconds(step.timeoutMs));
+        if (!seen) {
+            timeouts++;
+            return;
+        }
+        if (step.keys[0] == '\0') return;     // waiting for the timer, not a key
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - sent).count();
+        latencies.push_back(ms);
+        latenciesByKey[keyName(step.keys)].push_back(ms);
+    };
+
+    Clock::time_point measureStart = Clock::now();
+    uint64_t bytesBefore = cli.getBytes();
+    uint64_t framesBefore = cli.getFrames();
+    uint64_t clearsBefore = cli.getClears();
+
+    if (withRating) {
+        for (const Step& step : ratingScript) runStep(step);
+    }
+    Clock::time_point end = measureStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    uint64_t loops = 0;
+    while (Clock::now() < end) {
+        for (const Step& step : mainScript) runStep(step);
+        loops++;
+        // Let the idle screen refresh a few times between loops, like a user would
+        cli.pump(std::min(end, Clock::now() + std::chrono::milliseconds(300)));
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - measureStart).count();
+    uint64_t bytes = cli.getBytes() - bytesBefore;
+    uint64_t frames = cli.getFrames() - framesBefore;
+    uint64_t clears = cli.getClears() - clearsBefore;
+    cli.stop();
+
+    std::printf("{\"seconds\":%.3f,\"loops\":%llu,\"keys\":%zu,\"timeouts\":%llu,", elapsed,
+                static_cast<unsigned long long>(loops), latencies.size(), static_cast<unsigned long long>(timeouts));
+    std::printf("\"bytes\":%llu,\"bytes_per_sec\":%.1f,\"frames\":%llu,\"frames_per_sec\":%.2f,"
+                "\"bytes_per_frame\":%.1f,\"clears\":%llu,",
+                static_cast<unsigned long long>(bytes), elapsed > 0 ? bytes / elapsed : 0.0,
+                static_cast<unsigned long long>(frames), elapsed > 0 ? frames / elapsed : 0.0,
+                frames > 0 ? static_cast<double>(bytes) / frames : 0.0, static_cast<unsigned long long>(clears));
+    std::printf("\"latency_ms\":{\"p50\":%.3f,\"p99\":%.3f,\"max\":%.3f},\"per_key\":{",
+                percentile(latencies, 0.50), percentile(latencies, 0.99), percentile(latencies, 1.0));
+    bool first = true;
+    for (const auto& entry : latenciesByKey) {
+        std::printf("%s\"%s\":{\"count\":%zu,\"p50\":%.3f,\"p99\":%.3f}", first ? "" : ",", entry.first.c_str(),
+                    entry.second.size(), percentile(entry.second, 0.50), percentile(entry.second, 0.99));
+        first = false;
+    }
+    std::printf("}}\n");
+    return timeouts > 0 ? 2 : 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <iostream>
+
+/**
+ * Minimal assertions for the test executables: a failed CHECK prints the
+ * expression and location and the test's main returns checkResult(), which
+ * is non-zero if anything failed (ctest reports the exit code).
+ */
+
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            ++checkFailures();                                                           \
+        }                                                                                \
+    } while (0)
+
+inline int checkResult() {
+    if (checkFailures() > 0) std::cerr << checkFailures() << " check(s) failed" << std::endl;
+    return checkFailures() > 0 ? 1 : 0;
+}
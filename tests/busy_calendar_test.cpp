@@ -0,0 +1,173 @@
+// BusyCalendar: .ics import (RECURRENCE-ID overrides, EXDATE, weekly BYDAY) and nextFreeSlot
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BusyCalendar.h"
+#include "SessionLog.h"
+#include "Check.h"
+
+namespace {
+
+const int64_t hour = 3600;
+const int64_t day = 86400;
+
+typedef std::vector<BusyCalendar::Interval> Intervals;
+
+// Floating local time as in DTSTART, e.g. "20250310T100000"
+std::string icsTime(int64_t epoch) {
+    std::string text = formatEpoch(epoch);
+    std::string out;
+    for (char c : text) {
+        if (c == ' ') out.push_back('T');
+        else if (c != '-' && c != ':') out.push_back(c);
+    }
+    return out;
+}
+
+// 10:00 on the first Monday after today; imports only keep occurrences from yesterday on
+int64_t nextMonday() {
+    const int32_t today = epochDay(localNow());
+    const int32_t weekday = ((today + 3) % 7 + 7) % 7;     // Monday = 0
+    return static_cast<int64_t>(today + 7 - weekday) * day + 10 * hour;
+}
+
+bool importText(BusyCalendar& calendar, const std::string& body, std::string& report) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "pomodoro-busy-test.ics";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "BEGIN:VCALENDAR\r\nVERSION:2.0\r\n" << body << "END:VCALENDAR\r\n";
+    }
+    bool imported = calendar.importIcs(path.string(), report);
+    std::filesystem::remove(path);
+    return imported;
+}
+
+bool sameIntervals(const Intervals& actual, const Intervals& expected) {
+    if (actual.size() != expected.size()) return false;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (actual[i].start != expected[i].start || actual[i].end != expected[i].end) return false;
+    }
+    return true;
+}
+
+// One weekly occurrence moved and another cancelled by instances with a RECURRENCE-ID,
+// one listed before the recurring event and one after it
+void testOverride() {
+    const int64_t monday = nextMonday();
+    std::string body =
+        "BEGIN:VEVENT\r\nUID:standup\r\nRECURRENCE-ID:" + icsTime(monday + 7 * day) + "\r\n"
+        "DTSTART:" + icsTime(monday + 7 * day + 4 * hour) + "\r\n"
+        "DTEND:" + icsTime(monday + 7 * day + 5 * hour) + "\r\nEND:VEVENT\r\n"
+        "BEGIN:VEVENT\r\nUID:standup\r\nDTSTART;TZID=Europe/Berlin:" + icsTime(monday) + "\r\n"
+        "DURATION:PT1H\r\nRRULE:FREQ=WEEKLY;COUNT=4\r\nEND:VEVENT\r\n"
+        "BEGIN:VEVENT\r\nUID:standup\r\nRECURRENCE-ID:" + icsTime(monday + 14 * day) + "\r\n"
+        "DTSTART:" + icsTime(monday + 14 * day) + "\r\nDURATION:PT1H\r\nSTATUS:CANCELLED\r\nEND:VEVENT\r\n"
+        "BEGIN:VEVENT\r\nUID:other\r\nRECURRENCE-ID:" + icsTime(monday + 21 * day) + "\r\n"
+        "DTSTART:" + icsTime(monday + 2 * day) + "\r\nDURATION:PT30M\r\nEND:VEVENT\r\n";
+
+    BusyCalendar calendar("");
+    std::string report;
+    CHECK(importText(calendar, body, report));
+    // An override of another UID leaves the standup's occurrence in place
+    CHECK(sameIntervals(calendar.getIntervals(), Intervals{
+        { monday, monday + hour },
+        { monday + 2 * day, monday + 2 * day + 30 * 60 },
+        { monday + 7 * day + 4 * hour, monday + 7 * day + 5 * hour },
+        { monday + 21 * day, monday + 21 * day + hour } }));
+    CHECK(report.find("1 events with a TZID") != std::string::npos);
+}
+
+void testExdate() {
+    const int64_t monday = nextMonday();
+    std::string body =
+        "BEGIN:VEVENT\r\nUID:daily\r\nDTSTART:" + icsTime(monday) + "\r\n"
+        "DTEND:" + icsTime(monday + 2 * hour) + "\r\nRRULE:FREQ=DAILY;COUNT=5\r\n"
+        "EXDATE:" + icsTime(monday + day) + "," + icsTime(monday + 3 * day) + "\r\n"
+        "EXDATE:" + icsTime(monday + 4 * day + hour) + "\r\nEND:VEVENT\r\n";
+
+    BusyCalendar calendar("");
+    std::string report;
+    CHECK(importText(calendar, body, report));
+    // The last EXDATE does not match an occurrence time and excludes nothing
+    CHECK(sameIntervals(calendar.getIntervals(), Intervals{
+        { monday, monday + 2 * hour },
+        { monday + 2 * day, monday + 2 * day + 2 * hour },
+        { monday + 4 * day, monday + 4 * day + 2 * hour } }));
+}
+
+void testWeeklyByDay() {
+    const int64_t monday = nextMonday();
+    // Starts on a Wednesday, so the first Monday is skipped; every second week
+    std::string body =
+        "BEGIN:VEVENT\r\nUID:gym\r\nDTSTART:" + icsTime(monday + 2 * day) + "\r\n"
+        "DURATION:PT1H30M\r\nRRULE:FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE,FR;COUNT=5\r\nEND:VEVENT\r\n";
+
+    BusyCalendar calendar("");
+    std::string report;
+    CHECK(importText(calendar, body, report));
+    Intervals expected;
+    for (int64_t offset : { 2, 4, 14, 16, 18 }) {
+        expected.push_back({ monday + offset * day, monday + offset * day + 90 * 60 });
+    }
+    CHECK(sameIntervals(calendar.getIntervals(), expected));
+}
+
+void testNextFreeSlot() {
+    BusyCalendar calendar("");
+    CHECK(calendar.nextFreeSlot(1000, 60) == 1000);
+
+    // Overlapping and touching input is merged: [100, 200) [250, 300) [400, 500)
+    calendar.assign({ { 400, 500 }, { 100, 150 }, { 140, 200 }, { 250, 280 }, { 280, 300 } });
+    CHECK(calendar.size() == 3);
+
+    // Inside a busy period: the gap after it if long enough, else a later one
+    CHECK(calendar.nextFreeSlot(150, 50) == 200);
+    CHECK(calendar.nextFreeSlot(150, 51) == 300);
+    CHECK(calendar.nextFreeSlot(150, 101) == 500);
+    // Inside a gap: right away if the rest of it fits, otherwise after a later period
+    CHECK(calendar.nextFreeSlot(210, 40) == 210);
+    CHECK(calendar.nextFreeSlot(210, 41) == 300);
+    CHECK(calendar.nextFreeSlot(210, 1000) == 500);
+    CHECK(calendar.nextFreeSlot(0, 100) == 0);
+    CHECK(calendar.nextFreeSlot(0, 101) == 500);
+    // In or after the last busy period
+    CHECK(calendar.nextFreeSlot(450, 1000) == 500);
+    CHECK(calendar.nextFreeSlot(500, 1) == 500);
+    CHECK(calendar.nextFreeSlot(10000, 1000000) == 10000);
+
+    // Same answers as scanning the periods one by one
+    std::mt19937_64 random(5);
+    std::uniform_int_distribution<int64_t> startDraw(0, 100000);
+    std::uniform_int_distribution<int64_t> lengthDraw(1, 300);
+    Intervals busy(2000);
+    for (BusyCalendar::Interval& interval : busy) {
+        interval.start = startDraw(random);
+        interval.end = interval.start + lengthDraw(random);
+    }
+    calendar.assign(busy);
+    const Intervals& merged = calendar.getIntervals();
+    for (int query = 0; query < 5000; ++query) {
+        const int64_t from = startDraw(random);
+        const int64_t length = lengthDraw(random);
+        int64_t expected = from;
+        for (const BusyCalendar::Interval& interval : merged) {
+            if (interval.end <= expected) continue;
+            if (interval.start >= expected + length) break;
+            expected = interval.end;
+        }
+        CHECK(calendar.nextFreeSlot(from, length) == expected);
+    }
+}
+
+} // namespace
+
+int main() {
+    testOverride();
+    testExdate();
+    testWeeklyByDay();
+    testNextFreeSlot();
+    return checkResult();
+}
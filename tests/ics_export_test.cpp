@@ -0,0 +1,229 @@
+// export-ics output parsed back: RFC 5545 line folding, escaping and one event per block
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "IcsExport.h"
+#include "SessionLog.h"
+#include "TagTable.h"
+#include "Check.h"
+
+namespace {
+
+struct Property {
+    std::string name;
+    std::string value;
+};
+
+struct Event {
+    std::map<std::string, std::string> properties;
+};
+
+// Complete UTF-8 sequences only (a fold must not split one)
+bool validUtf8(const std::string& text) {
+    for (size_t i = 0; i < text.size();) {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        size_t length = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+        if (length == 0 || i + length > text.size()) return false;
+        for (size_t k = 1; k < length; ++k) {
+            if ((static_cast<unsigned char>(text[i + k]) & 0xC0) != 0x80) return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+std::string unescapeText(const std::string& value) {
+    std::string out;
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\' && i + 1 < value.size()) {
+            char next = value[++i];
+            out += next == 'n' || next == 'N' ? '\n' : next;
+        } else {
+            out += value[i];
+        }
+    }
+    return out;
+}
+
+// Split into CRLF lines, check every physical line, unfold and parse "NAME:value"
+std::vector<Property> parseContentLines(const std::string& ics) {
+    std::vector<Property> properties;
+    CHECK(ics.size() >= 2 && ics.compare(ics.size() - 2, 2, "\r\n") == 0);
+    std::string logical;
+    auto finish = [&]() {
+        if (logical.empty()) return;
+        size_t colon = logical.find(':');
+        CHECK(colon != std::string::npos && colon > 0);
+        if (colon != std::string::npos) properties.push_back(Property{ logical.substr(0, colon), logical.substr(colon + 1) });
+        logical.clear();
+    };
+    size_t pos = 0;
+    while (pos < ics.size()) {
+        size_t end = ics.find("\r\n", pos);
+        if (end == std::string::npos) end = ics.size();
+        std::string physical = ics.substr(pos, end - pos);
+        pos = end + 2;
+
+        CHECK(physical.size() <= 75);
+        CHECK(physical.find('\n') == std::string::npos && physical.find('\r') == std::string::npos);
+        CHECK(validUtf8(physical));
+        if (physical.size() > 75 || !validUtf8(physical)) std::cerr << "  line: " << physical << "\n";
+
+        if (!physical.empty() && (physical[0] == ' ' || physical[0] == '\t')) {
+            CHECK(!logical.empty());
+            logical += physical.substr(1);
+        } else {
+            finish();
+            logical = physical;
+        }
+    }
+    finish();
+    return properties;
+}
+
+std::vector<Event> parseCalendar(const std::string& ics) {
+    std::vector<Event> events;
+    std::vector<std::string> open;
+    for (const Property& property : parseContentLines(ics)) {
+        if (property.name == "BEGIN") {
+            open.push_back(property.value);
+            if (property.value == "VEVENT") events.emplace_back();
+        } else if (property.name == "END") {
+            CHECK(!open.empty() && open.back() == property.value);
+            if (!open.empty()) open.pop_back();
+        } else if (!open.empty() && open.back() == "VEVENT") {
+            CHECK(events.back().properties.count(property.name) == 0);
+            events.back().properties[property.name] = property.value;
+        } else {
+            CHECK(open.size() == 1 && open[0] == "VCALENDAR");
+        }
+    }
+    CHECK(open.empty());
+    return events;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::string repeat(const std::string& text, int count) {
+    std::string out;
+    for (int i = 0; i < count; ++i) out += text;
+    return out;
+}
+
+std::string icsDateTime(int64_t epoch) {
+    std::string text = formatEpoch(epoch);     // "YYYY-MM-DD HH:MM:SS"
+    return text.substr(0, 4) + text.substr(5, 2) + text.substr(8, 2) + "T" +
+           text.substr(11, 2) + text.substr(14, 2) + text.substr(17, 2);
+}
+
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pomodoro-ics-test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::filesystem::current_path(dir);
+
+    // Tags that land multi-byte characters and escapes on the fold boundary
+    const std::vector<std::string> tagNames = {
+        repeat("a", 21) + repeat("\xC3\xA9", 40),                 // 'é'
+        repeat("b", 20) + repeat("\xE6\x97\xA5\xE6\x9C\xAC", 20), // '日本'
+        repeat("c", 19) + repeat("\xF0\x9F\x8D\x85", 25),         // tomato emoji
+        "comma, semicolon; back\\slash " + repeat(",;", 40),
+        repeat("x", 200),
+    };
+    TagTable tags;
+    std::vector<uint32_t> tagIds = { 0 };
+    for (const std::string& name : tagNames) tagIds.push_back(tags.intern(name));
+
+    std::vector<LogRecord> blocks;
+    {
+        std::ofstream log("log.txt");
+        int64_t time = civilToEpoch(2025, 3, 1, 8);
+        const LogEvent kinds[] = { LogEvent::Focus, LogEvent::Hyperfocus, LogEvent::Rest };
+        const Rating ratings[] = { Rating::Good, Rating::Bad, Rating::Okay };
+        for (int i = 0; i < 240; ++i) {
+            LogRecord started;
+            started.timestamp = time;
+            log << formatLogLine(started) << "\n";
+
+            LogRecord block;
+            block.event = kinds[i % 3];
+            block.rating = block.event == LogEvent::Focus ? ratings[(i / 3) % 3] : Rating::None;
+            block.value = 5 + i % 50;
+            block.tagId = tagIds[i % tagIds.size()];
+            block.timestamp = time + block.value * 60;
+            log << formatLogLine(block) << "\n";
+            blocks.push_back(block);
+
+            LogRecord idle;
+            idle.event = LogEvent::Idle;
+            idle.value = 3;
+            idle.timestamp = block.timestamp + 180;
+            log << formatLogLine(idle) << "\n";
+            time += 6 * 3600;
+        }
+    }
+
+    IcsExportStats stats;
+    CHECK(exportIcs("log.txt", "sessions.ics", INT32_MIN, INT32_MAX, stats));
+    CHECK(stats.records == 3 * blocks.size());
+    CHECK(stats.events == blocks.size());
+    const std::string ics = readFile("sessions.ics");
+    CHECK(stats.bytes == ics.size());
+
+    std::vector<Event> events = parseCalendar(ics);
+    CHECK(events.size() == blocks.size());
+    std::set<std::string> uids;
+    for (size_t i = 0; i < events.size() && i < blocks.size(); ++i) {
+        const LogRecord& block = blocks[i];
+        std::map<std::string, std::string>& p = events[i].properties;
+        std::string name = block.event == LogEvent::Focus ? "Focus" : block.event == LogEvent::Hyperfocus ? "Hyperfocus" : "Rest";
+        std::string rating = ratingName(block.rating);
+        const std::string& tag = tags.name(block.tagId);
+
+        std::string summary = name + (rating.empty() ? "" : " (" + rating + ")") + (tag.empty() ? "" : " - " + tag);
+        std::string description = name + ": " + std::to_string(block.value) + " min" +
+                                  (rating.empty() ? "" : ", rated " + rating) + (tag.empty() ? "" : ", tag " + tag);
+        CHECK(unescapeText(p["SUMMARY"]) == summary);
+        CHECK(unescapeText(p["DESCRIPTION"]) == description);
+        CHECK(p["CATEGORIES"] == name);
+        CHECK(p["DTSTART"] == icsDateTime(block.timestamp - block.value * 60));
+        CHECK(p["DTEND"] == icsDateTime(block.timestamp));
+        CHECK(p.count("DTSTAMP") == 1);
+        CHECK(uids.insert(p["UID"]).second);
+    }
+
+    // A day range exports only the blocks ending inside it, with the same UIDs
+    const int32_t fromDay = epochDay(blocks[40].timestamp);
+    const int32_t toDay = epochDay(blocks[79].timestamp);
+    CHECK(exportIcs("log.txt", "range.ics", fromDay, toDay, stats));
+    std::vector<Event> range = parseCalendar(readFile("range.ics"));
+    size_t expected = 0;
+    for (const LogRecord& block : blocks) {
+        int32_t day = epochDay(block.timestamp);
+        if (day >= fromDay && day <= toDay) ++expected;
+    }
+    CHECK(range.size() == expected);
+    for (const Event& event : range) CHECK(uids.count(event.properties.at("UID")) == 1);
+
+    // Without a history the export fails and leaves an existing calendar untouched
+    const std::string before = readFile("sessions.ics");
+    IcsExportStats missing;
+    CHECK(!exportIcs("missing.txt", "sessions.ics", INT32_MIN, INT32_MAX, missing));
+    CHECK(readFile("sessions.ics") == before);
+    CHECK(!std::filesystem::exists("sessions.ics.tmp"));
+
+    std::filesystem::current_path(std::filesystem::temp_directory_path());
+    std::filesystem::remove_all(dir);
+    return checkResult();
+}
@@ -0,0 +1,234 @@
+// QualityModel: constant update cost, quality.bin round trip and backfill, suggestion bounds
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "QualityModel.h"
+#include "Check.h"
+
+namespace {
+
+// One session per synthetic day with 1-4 rated blocks; P(Good) peaks at the given durations
+std::vector<LogRecord> makeRecords(size_t blockCount, int bestFocus, int bestRest, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> focusDraw(1, 120);
+    std::uniform_int_distribution<int> restDraw(1, 40);
+    std::uniform_int_distribution<int> hourDraw(7, 20);
+    std::uniform_int_distribution<int> tagDraw(0, 3);
+    std::uniform_real_distribution<double> unit(0, 1);
+
+    std::vector<LogRecord> records;
+    int64_t day = civilToEpoch(2024, 1, 1);
+    size_t blocks = 0;
+    while (blocks < blockCount) {
+        uint32_t tag = static_cast<uint32_t>(tagDraw(rng));
+        int64_t t = day + hourDraw(rng) * 3600;
+        LogRecord started;
+        started.timestamp = t;
+        started.event = LogEvent::SessionStarted;
+        started.tagId = tag;
+        records.push_back(started);
+        int rest = 0;
+        int count = 1 + static_cast<int>(unit(rng) * 4);
+        for (int i = 0; i < count && blocks < blockCount; ++i, ++blocks) {
+            int focus = focusDraw(rng);
+            t += static_cast<int64_t>(rest + focus) * 60;
+            double f = std::log(static_cast<double>(focus) / bestFocus);
+            double r = std::log(static_cast<double>(i == 0 ? bestRest : rest) / bestRest);
+            double p = 1 / (1 + std::exp(-(1 - 3 * f * f - r * r)));
+            LogRecord rated;
+            rated.timestamp = t;
+            rated.event = LogEvent::Focus;
+            rated.value = static_cast<uint32_t>(focus);
+            rated.rating = unit(rng) < p ? Rating::Good : (unit(rng) < 0.5 ? Rating::Okay : Rating::Bad);
+            rated.tagId = tag;
+            records.push_back(rated);
+            rest = restDraw(rng);
+        }
+        LogRecord finished;
+        finished.timestamp = t + rest * 60;
+        finished.event = LogEvent::SessionFinished;
+        finished.tagId = tag;
+        records.push_back(finished);
+        day += 86400;
+    }
+    return records;
+}
+
+std::filesystem::path freshDirectory(const char* name) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+// Nanoseconds per record for add() over records[from, from + count), best of a few runs on copies
+double updateCost(const QualityModel& trained, const std::vector<LogRecord>& records, size_t from, size_t count) {
+    double best = 1e18;
+    for (int run = 0; run < 5; ++run) {
+        QualityModel model = trained;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = from; i < from + count; ++i) model.add(records[i]);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds * 1e9 / count);
+        CHECK(model.getSamples() >= trained.getSamples());
+    }
+    return best;
+}
+
+// An update touches each feature once: neither its time nor the saved state grows with the history
+void testUpdateCost() {
+    std::filesystem::path dir = freshDirectory("pomodoro-quality-cost-test");
+    const std::string path = (dir / "quality.bin").string();
+    std::vector<LogRecord> records = makeRecords(400000, 35, 6, 1);
+    const size_t batch = 20000;
+
+    QualityModel model(path, "");
+    for (size_t i = 0; i < batch; ++i) model.add(records[i]);
+    CHECK(model.save());
+    const auto earlyBytes = std::filesystem::file_size(path);
+    double early = updateCost(model, records, batch, batch);
+
+    for (size_t i = batch; i < records.size() - batch; ++i) model.add(records[i]);
+    CHECK(model.save());
+    CHECK(std::filesystem::file_size(path) == earlyBytes);
+    CHECK(earlyBytes < 1024);
+    double late = updateCost(model, records, records.size() - batch, batch);
+    if (late > 3 * early + 50) std::cerr << "  update " << early << " ns early, " << late << " ns late\n";
+    CHECK(late <= 3 * early + 50);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Everything the model predicts from, including the tracked session context, survives quality.bin
+void testRoundTrip() {
+    std::filesystem::path dir = freshDirectory("pomodoro-quality-file-test");
+    const std::string path = (dir / "quality.bin").string();
+    std::vector<LogRecord> records = makeRecords(5000, 35, 6, 2);
+    // Stop inside a session so the context is not the default one
+    size_t cut = records.size() - 1;
+    while (records[cut].event != LogEvent::Focus) --cut;
+
+    QualityModel model(path, "");
+    for (size_t i = 0; i <= cut; ++i) model.add(records[i]);
+    CHECK(model.save());
+
+    QualityModel loaded(path, "");
+    CHECK(loaded.getSamples() == model.getSamples());
+    CHECK(loaded.getGood() == model.getGood());
+    const int64_t lastEnd = records[cut].timestamp;
+    for (int64_t offset : { 60, 5 * 60, 20 * 60, 4 * 3600 }) {
+        for (uint32_t tag : { 0u, 1u, 3u }) {
+            QualityModel::Context a = model.contextAt(lastEnd + offset, tag);
+            QualityModel::Context b = loaded.contextAt(lastEnd + offset, tag);
+            CHECK(a.first == b.first && a.previousFocus == b.previousFocus && a.rest == b.rest && a.idle == b.idle);
+            for (int minutes : { 5, 25, 50, 90 }) {
+                CHECK(model.predict(a, minutes) == loaded.predict(b, minutes));
+            }
+            QualityModel::Suggestion x = model.suggest(lastEnd + offset, tag, 25, 5);
+            QualityModel::Suggestion y = loaded.suggest(lastEnd + offset, tag, 25, 5);
+            CHECK(x.focusMinutes == y.focusMinutes && x.restMinutes == y.restMinutes && x.probability == y.probability);
+        }
+    }
+    CHECK(!model.contextAt(lastEnd + 60, 0).first);
+
+    // Training continues identically, including the step sizes
+    for (size_t i = cut + 1; i < records.size(); ++i) {
+        model.add(records[i]);
+        loaded.add(records[i]);
+    }
+    QualityModel::Context context = model.contextAt(lastEnd + 86400, 2);
+    CHECK(model.predict(context, 30) == loaded.predict(context, 30));
+
+    // A damaged file is rejected and leaves an empty model
+    {
+        std::ofstream damaged(path, std::ios::binary | std::ios::trunc);
+        damaged << "PQLM garbage";
+    }
+    QualityModel rejected(path, "");
+    CHECK(rejected.getSamples() == 0);
+    CHECK(!rejected.load(path));
+
+    std::filesystem::remove_all(dir);
+}
+
+// A model created next to an existing log is trained on the ratings already in it
+void testBackfill() {
+    std::filesystem::path dir = freshDirectory("pomodoro-quality-backfill-test");
+    const std::string logPath = (dir / "log.txt").string();
+    const std::string path = (dir / "quality.bin").string();
+    {
+        std::ofstream log(logPath);
+        const char* const ratings[] = { "Good", "Bad", "Okay" };
+        for (int day = 1; day <= 10; ++day) {
+            char date[16];
+            std::snprintf(date, sizeof(date), "2025-03-%02d", day);
+            log << date << " 09:00:00 - Session started\n";
+            for (int block = 0; block < 3; ++block) {
+                log << date << " " << (10 + block) << ":00:00 - Focus: 25 min (" << ratings[(day + block) % 3] << ")\n";
+                log << date << " " << (10 + block) << ":05:00 - Rest: 5 min\n";
+            }
+            log << date << " 13:00:00 - Session finished at 75:00\n";
+        }
+    }
+
+    QualityModel model(path, logPath);
+    CHECK(model.getSamples() == 0);
+    CHECK(model.backfill());
+    CHECK(std::filesystem::exists(path));
+    CHECK(!model.backfill());
+    CHECK(model.getSamples() == 30);
+    CHECK(model.getGood() == 10);
+
+    QualityModel reloaded(path, logPath);
+    CHECK(reloaded.getSamples() == 30);
+    CHECK(!reloaded.backfill());
+
+    std::filesystem::remove_all(dir);
+}
+
+// Suggestions stay between half and twice the configured durations, even when the history
+// says much longer or much shorter blocks go better
+void testSuggestionBounds() {
+    const int configurations[][2] = { { 25, 5 }, { 10, 3 }, { 5, 1 }, { 45, 15 }, { 25, 7 }, { 1, 1 } };
+    const int optima[][2] = { { 110, 35 }, { 2, 1 }, { 35, 6 } };
+    uint64_t seed = 3;
+    for (const auto& optimum : optima) {
+        QualityModel model("", "");
+        std::vector<LogRecord> records = makeRecords(20000, optimum[0], optimum[1], seed++);
+        for (const LogRecord& record : records) model.add(record);
+        const int64_t after = records.back().timestamp;
+
+        for (const auto& configured : configurations) {
+            for (int64_t offset : { 3600, 86400 + 9 * 3600, 2 * 86400 + 19 * 3600 }) {
+                QualityModel::Suggestion suggestion = model.suggest(after + offset, 1, configured[0], configured[1]);
+                CHECK(suggestion.ready);
+                CHECK(2 * suggestion.focusMinutes >= configured[0]);
+                CHECK(suggestion.focusMinutes <= 2 * configured[0]);
+                CHECK(2 * suggestion.restMinutes >= configured[1]);
+                CHECK(suggestion.restMinutes <= 2 * configured[1]);
+                CHECK(suggestion.probability >= suggestion.current);
+            }
+        }
+    }
+
+    // Without enough ratings the configured durations come back unchanged
+    QualityModel fresh("", "");
+    QualityModel::Suggestion suggestion = fresh.suggest(civilToEpoch(2024, 1, 1), 0, 25, 5);
+    CHECK(!suggestion.ready);
+    CHECK(suggestion.focusMinutes == 25 && suggestion.restMinutes == 5);
+}
+
+} // namespace
+
+int main() {
+    testUpdateCost();
+    testRoundTrip();
+    testBackfill();
+    testSuggestionBounds();
+    return checkResult();
+}
@@ -0,0 +1,137 @@
+// Accuracy and size bounds of QuantileSketch, and SketchStore backfill from an existing log
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "QuantileSketch.h"
+#include "Check.h"
+
+namespace {
+
+const double quantiles[] = { 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999 };
+
+// Midpoint rank of value in sorted data, as a fraction
+double rankOf(const std::vector<double>& sorted, double value) {
+    auto low = std::lower_bound(sorted.begin(), sorted.end(), value);
+    auto high = std::upper_bound(sorted.begin(), sorted.end(), value);
+    return ((low - sorted.begin()) + (high - sorted.begin())) / 2.0 / sorted.size();
+}
+
+// Rank error allowed at q: t-digest keeps the tails much tighter than the middle
+double allowedError(double q) {
+    return 0.001 + 0.01 * q * (1 - q);
+}
+
+void checkAccuracy(const QuantileSketch& sketch, const std::vector<double>& sorted) {
+    for (double q : quantiles) {
+        double error = std::fabs(rankOf(sorted, sketch.quantile(q)) - q);
+        if (error > allowedError(q)) std::cerr << "  q=" << q << " rank error " << error << "\n";
+        CHECK(error <= allowedError(q));
+    }
+    CHECK(sketch.quantile(0) == sorted.front());
+    CHECK(sketch.quantile(1) == sorted.back());
+}
+
+void testDistribution(std::vector<double> values) {
+    QuantileSketch single;
+    for (double v : values) single.add(v);
+
+    // The same data split across several sketches and merged
+    std::vector<QuantileSketch> parts(8);
+    for (size_t i = 0; i < values.size(); ++i) parts[i % parts.size()].add(values[i]);
+    QuantileSketch merged;
+    for (const QuantileSketch& part : parts) merged.merge(part);
+
+    std::sort(values.begin(), values.end());
+    CHECK(single.count() == values.size());
+    CHECK(merged.count() == values.size());
+    checkAccuracy(single, values);
+    checkAccuracy(merged, values);
+}
+
+// Memory and file size depend on the compression only, not on how many values were added
+void testSizeBound() {
+    const double compression = 100;
+    std::mt19937_64 random(7);
+    std::lognormal_distribution<double> minutes(3.0, 0.6);
+    QuantileSketch sketch(compression);
+    for (size_t n = 1; n <= 2000000; ++n) {
+        sketch.add(minutes(random));
+        if (n == 1000 || n == 100000 || n == 2000000) {
+            CHECK(sketch.centroidCount() <= static_cast<size_t>(compression));
+
+            std::FILE* file = std::tmpfile();
+            CHECK(file != nullptr);
+            if (!file) return;
+            sketch.write(file);
+            long bytes = std::ftell(file);
+            CHECK(bytes <= 20 + 8 * static_cast<long>(compression));
+
+            // What is read back answers the same (means are stored as float)
+            std::rewind(file);
+            QuantileSketch copy(compression);
+            CHECK(copy.read(file));
+            std::fclose(file);
+            CHECK(copy.count() == sketch.count());
+            for (double q : quantiles) {
+                CHECK(std::fabs(copy.quantile(q) - sketch.quantile(q)) <= 1e-4 * sketch.quantile(q));
+            }
+        }
+    }
+}
+
+// A store created next to an existing log starts with the whole history
+void testBackfill() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pomodoro-sketch-test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const std::string logPath = (dir / "log.txt").string();
+    const std::string sketchPath = (dir / "sketches.bin").string();
+    {
+        std::ofstream log(logPath);
+        log << "2025-03-01 09:00:00 - Session started\n";
+        for (int i = 0; i < 40; ++i) {
+            log << "2025-03-01 09:30:00 - Focus: " << (10 + i) << " min (Good)\n";
+            log << "2025-03-01 09:35:00 - Rest: 5 min\n";
+        }
+        log << "2025-03-01 12:00:00 - Hyperfocus: 90 min\n";
+    }
+
+    SketchStore store(sketchPath, logPath);
+    CHECK(store.sketch(SketchStore::Focus).count() == 0);
+    CHECK(store.backfill());
+    CHECK(std::filesystem::exists(sketchPath));
+    CHECK(!store.backfill());
+    CHECK(store.sketch(SketchStore::Focus).count() == 40);
+    CHECK(store.sketch(SketchStore::FocusGood).count() == 40);
+    CHECK(store.sketch(SketchStore::Rest).count() == 40);
+    CHECK(store.sketch(SketchStore::Hyperfocus).count() == 1);
+    CHECK(store.sketch(SketchStore::Focus).min() == 10);
+    CHECK(store.sketch(SketchStore::Focus).max() == 49);
+
+    SketchStore reloaded(sketchPath, logPath);
+    CHECK(reloaded.sketch(SketchStore::Focus).count() == 40);
+    CHECK(reloaded.sketch(SketchStore::Rest).quantile(0.5) == 5);
+
+    std::filesystem::remove_all(dir);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937_64 random(42);
+    std::lognormal_distribution<double> lognormal(3.0, 0.6);
+    std::uniform_real_distribution<double> uniform(0, 120);
+    std::vector<double> a(500000), b(500000);
+    for (double& v : a) v = lognormal(random);
+    for (double& v : b) v = uniform(random);
+
+    testDistribution(a);
+    testDistribution(b);
+    testSizeBound();
+    testBackfill();
+    return checkResult();
+}